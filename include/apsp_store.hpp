@@ -0,0 +1,54 @@
+#ifndef APSP_STORE_HPP
+#define APSP_STORE_HPP
+
+#include <mpi.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+// Row-distributed storage for all-pairs shortest path results.
+// The shared output file is an N x N row-major matrix of doubles. Each rank
+// writes only the rows of the sources it computed, straight to their offset
+// with MPI-IO, so no rank ever holds the full N^2 matrix.
+class APSPRowStore {
+public:
+    // Collective: every rank in comm must open the same path
+    APSPRowStore(const std::string& path, int node_count,
+                 MPI_Comm comm = MPI_COMM_WORLD, bool cache_rows = false);
+    // Closes the file if close() was not called, unless an exception is
+    // unwinding: the close is collective and could hang on one rank
+    ~APSPRowStore();
+
+    APSPRowStore(const APSPRowStore&) = delete;
+    APSPRowStore& operator=(const APSPRowStore&) = delete;
+
+    // Write the distance row of `source` (independent, non-collective)
+    void put_row(int source, const std::vector<double>& distances);
+
+    // Collective: makes rows written by any rank readable by all ranks
+    void sync();
+
+    // Fetch a row on demand. Cached local rows are served from memory,
+    // everything else is read from the shared file (call sync() first).
+    std::vector<double> get_row(int source);
+
+    // Collective
+    void close();
+
+    int node_count() const { return n; }
+    const std::vector<int>& local_sources() const { return written_sources; }
+
+private:
+    MPI_Comm comm;
+    MPI_File file;
+    int n;
+    bool is_open;
+    bool cache_rows;
+    int uncaught_at_open = 0;  // exceptions in flight when the store was opened
+    std::vector<int> written_sources;
+    std::unordered_map<int, std::vector<double>> cached_rows;
+
+    MPI_Offset row_offset(int source) const;
+};
+
+#endif // APSP_STORE_HPP
@@ -0,0 +1,104 @@
+#ifndef ASYNC_SSSP_HPP
+#define ASYNC_SSSP_HPP
+
+#include "graph.hpp"
+#include "indexed_heap.hpp"
+#include <mpi.h>
+#include <vector>
+#include <cstdint>
+
+// Asynchronous distributed SSSP over one-sided MPI. Like DistributedSSSP,
+// every rank owns the nodes with owner[v] == rank and runs a local Dijkstra
+// on them, but there are no exchange rounds:
+//   - each rank exposes an inbox window with one (distance, predecessor)
+//     slot per owned node; remote relaxations land there through
+//     MPI_Accumulate(MPI_MINLOC), so concurrent senders keep the best one
+//   - after flushing a batch, the sender sets each slot's dirty flag; a slot
+//     that was clean is appended to the owner's notification ring, whose tail
+//     is the owner's counter window. A slot sits in the ring at most once, so
+//     the ring never holds more entries than the owner has nodes, and a poll
+//     only reads the entries past the owner's head: its cost follows the
+//     updates that arrived, not the number of owned nodes
+//   - Safra's algorithm detects termination: a token circulates the ring
+//     summing sent - received ring entries and turns black if any rank
+//     received updates since the token last passed it
+// Ranks that converge early simply idle-poll instead of waiting at barriers.
+class AsyncSSSP {
+public:
+    AsyncSSSP(const DynamicGraph& graph, const std::vector<int>& owner,
+              MPI_Comm comm = MPI_COMM_WORLD, size_t objective = 0);
+    ~AsyncSSSP();
+
+    AsyncSSSP(const AsyncSSSP&) = delete;
+    AsyncSSSP& operator=(const AsyncSSSP&) = delete;
+
+    // Collective
+    void compute(int source);
+
+    // Distance / predecessor of a node this rank owns (or of any node on the
+    // root after gather)
+    double get_distance(int node) const;
+    int get_predecessor(int node) const;
+
+    // Collective: complete distances and predecessors on `root`
+    void gather(int root = 0);
+
+    // Node sequence source -> target; call gather() first on the querying rank
+    std::vector<int> get_path(int target) const;
+
+    // Token rounds Safra's algorithm needed on rank 0, and updates this rank
+    // pushed to other ranks, in the last compute
+    size_t get_token_rounds() const { return token_rounds; }
+    size_t get_remote_updates() const { return remote_updates; }
+
+private:
+    // Matches MPI_DOUBLE_INT
+    struct DistPred {
+        double dist;
+        int pred;
+    };
+
+    struct Token {
+        long long count;  // sum of sent - received over the ranks passed
+        int black;
+    };
+
+    const DynamicGraph& graph;
+    std::vector<int> owner;
+    MPI_Comm comm;
+    int rank;
+    int size;
+    size_t objective;
+
+    std::vector<int> slot;       // node -> slot in its owner's inbox
+    std::vector<int> owned;      // local slot -> node
+    std::vector<int> capacity;   // rank -> slots (and ring entries) it owns
+    MPI_Win inbox_win = MPI_WIN_NULL;
+    MPI_Win dirty_win = MPI_WIN_NULL;
+    MPI_Win ring_win = MPI_WIN_NULL;
+    MPI_Win counter_win = MPI_WIN_NULL;
+    DistPred* inbox = nullptr;
+    int* dirty = nullptr;        // per slot: queued in the ring, not yet read
+    int* ring = nullptr;         // slot ids, -1 while a reserved entry is unwritten
+    long long* counter = nullptr;  // ring tail: entries ever reserved
+    long long head = 0;          // ring entries consumed so far
+
+    std::vector<double> distances;
+    std::vector<int> predecessors;
+    std::vector<double> sent;  // best distance already pushed for a remote node
+    IndexedDaryHeap<4> heap;
+
+    // Safra state
+    long long sent_count = 0;
+    long long received_count = 0;
+    bool black = false;
+    size_t token_rounds = 0;
+    size_t remote_updates = 0;
+
+    void relax(int node, double dist, int pred);
+    bool expand_batch();
+    void poll_inbox();
+    bool handle_termination(bool& token_out, bool& holding_token, Token& token);
+};
+
+#endif // ASYNC_SSSP_HPP
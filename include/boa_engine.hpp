@@ -0,0 +1,127 @@
+#pragma once
+#include "graph.hpp"
+#include "query_pool.hpp"
+#include "path_result.hpp"
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+// Bi-objective A* (BOA*) for the common time vs cost case.
+//
+// Both objectives get an exact lower bound from a reverse Dijkstra to the
+// target. Labels are expanded in lexicographic (f1, f2) order with f = g + h,
+// so a label is dominated exactly when its g2 is not below the best g2 already
+// settled at its node: the dominance check is one comparison against
+// g2_min[node] instead of a scan over the node's label set. Labels that cannot
+// beat the best g2 found at the target are pruned before they are queued.
+class BOAEngine {
+    const DynamicGraph& graph;
+    size_t first;   // weight index of the primary objective
+    size_t second;  // weight index of the secondary objective
+
+    struct Label {
+        double g1, g2;
+        double f1, f2;
+        int node;
+        int parent;  // label index, -1 at the source
+    };
+
+    // Reused between queries
+    std::vector<Label> labels;
+    std::vector<std::pair<std::pair<double, double>, int>> open;  // ((f1, f2), label)
+    std::vector<double> g2_min;
+    std::vector<double> h1, h2;
+    QueryContext heuristic_contexts[2];
+    size_t expanded = 0;
+
+public:
+    explicit BOAEngine(const DynamicGraph& g, size_t first_objective = 0, size_t second_objective = 1)
+        : graph(g), first(first_objective), second(second_objective) {}
+
+    // Pareto front source -> target, ordered by the first objective (second
+    // objective strictly decreasing). Empty if target is unreachable.
+    std::vector<PathResult> compute_pareto(int source, int target) {
+        const double INF = std::numeric_limits<double>::max();
+        const int n = graph.node_count();
+        if (source < 0 || source >= n || target < 0 || target >= n) return {};
+
+        compute_heuristics(target);
+        if (h1[source] == INF) return {};
+
+        labels.clear();
+        open.clear();
+        g2_min.assign(n, INF);
+        expanded = 0;
+
+        std::vector<int> solutions;
+        auto push = [&](double g1, double g2, int node, int parent) {
+            labels.push_back({g1, g2, g1 + h1[node], g2 + h2[node], node, parent});
+            const Label& label = labels.back();
+            open.push_back({{label.f1, label.f2}, static_cast<int>(labels.size()) - 1});
+            std::push_heap(open.begin(), open.end(), std::greater<>());
+        };
+
+        push(0.0, 0.0, source, -1);
+        while (!open.empty()) {
+            std::pop_heap(open.begin(), open.end(), std::greater<>());
+            int id = open.back().second;
+            open.pop_back();
+
+            const Label label = labels[id];
+            if (label.g2 >= g2_min[label.node] || label.f2 >= g2_min[target]) continue;
+            g2_min[label.node] = label.g2;
+            ++expanded;
+
+            if (label.node == target) {
+                solutions.push_back(id);
+                continue;
+            }
+
+            for (const auto& edge : graph.get_edges(label.node)) {
+                const int v = edge.target;
+                if (h1[v] == INF) continue;  // cannot reach the target
+                double g1 = label.g1 + edge.weights[first];
+                double g2 = label.g2 + edge.weights[second];
+                if (g2 >= g2_min[v] || g2 + h2[v] >= g2_min[target]) continue;
+                push(g1, g2, v, id);
+            }
+        }
+
+        std::vector<PathResult> front(solutions.size());
+        for (size_t r = 0; r < solutions.size(); ++r) {
+            const Label& label = labels[solutions[r]];
+            front[r].objectives = {label.g1, label.g2};
+            for (int l = solutions[r]; l != -1; l = labels[l].parent) {
+                front[r].nodes.push_back(labels[l].node);
+            }
+            std::reverse(front[r].nodes.begin(), front[r].nodes.end());
+        }
+        return front;
+    }
+
+    // Labels expanded by the last compute_pareto call
+    size_t get_expanded_count() const { return expanded; }
+
+private:
+    // h1/h2: exact single-objective distances to target, from one reverse
+    // Dijkstra per objective (run concurrently)
+    void compute_heuristics(int target) {
+        const DynamicGraph reverse = graph.reversed();
+        const size_t objectives[2] = {first, second};
+
+        #pragma omp parallel for num_threads(2)
+        for (int i = 0; i < 2; ++i) {
+            heuristic_contexts[i].run(reverse, target, -1, objectives[i]);
+        }
+
+        const int n = graph.node_count();
+        h1.resize(n);
+        h2.resize(n);
+        for (int v = 0; v < n; ++v) {
+            h1[v] = heuristic_contexts[0].get_distance(v);
+            h2[v] = heuristic_contexts[1].get_distance(v);
+        }
+    }
+};
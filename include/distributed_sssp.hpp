@@ -0,0 +1,79 @@
+#ifndef DISTRIBUTED_SSSP_HPP
+#define DISTRIBUTED_SSSP_HPP
+
+#include "graph.hpp"
+#include <mpi.h>
+#include <vector>
+#include <map>
+#include <cstdint>
+
+// Distributed delta-stepping SSSP. Every rank owns the nodes with
+// owner[v] == rank and only needs their out-edges, e.g. the local partition
+// from MPIDistributor; node IDs stay global.
+//
+// Each rank keeps delta-wide buckets for its own nodes. A bucket phase
+// relaxes light edges (weight <= delta) until bucket b is empty on every
+// rank, then the heavy edges of the nodes settled in b. Relaxations of nodes
+// owned elsewhere are batched per destination rank and exchanged once per
+// round with MPI_Alltoallv. An MPI_Allreduce(MIN) over the ranks' smallest
+// non-empty bucket picks the next phase and detects termination.
+class DistributedSSSP {
+public:
+    // delta <= 0 picks the mean edge weight of the objective
+    DistributedSSSP(const DynamicGraph& graph, const std::vector<int>& owner,
+                    MPI_Comm comm = MPI_COMM_WORLD, double delta = 0.0, size_t objective = 0);
+
+    // Collective
+    void compute(int source);
+
+    // Distance / predecessor of a node this rank owns (or of any node on the
+    // root after gather)
+    double get_distance(int node) const;
+    int get_predecessor(int node) const;
+
+    // Collective: complete distances and predecessors on `root`
+    void gather(int root = 0);
+
+    // Node sequence source -> target; needs every node on the path, so call
+    // gather() first on the querying rank
+    std::vector<int> get_path(int target) const;
+
+    double get_delta() const { return delta; }
+    // Bucket phases and exchange rounds of the last compute
+    size_t get_phase_count() const { return phases; }
+    size_t get_exchange_count() const { return exchanges; }
+
+private:
+    struct Relaxation {
+        double dist;
+        int node;
+        int pred;
+    };
+
+    const DynamicGraph& graph;
+    std::vector<int> owner;
+    MPI_Comm comm;
+    int rank;
+    int size;
+    double delta;
+    size_t objective;
+
+    std::vector<double> distances;
+    std::vector<int> predecessors;
+    std::vector<double> sent;  // best distance already sent for a remote node
+    std::map<uint64_t, std::vector<int>> buckets;  // sparse: weights can span many deltas
+    size_t phases = 0;
+    size_t exchanges = 0;
+
+    std::vector<std::vector<Relaxation>> outgoing;  // per destination rank
+
+    uint64_t bucket_of(double dist) const { return static_cast<uint64_t>(dist / delta); }
+    bool owns(int node) const { return owner[node] == rank; }
+
+    void relax(int node, double dist, int pred);
+    void relax_edges(int u, bool light);
+    void exchange();
+    uint64_t local_min_bucket();
+};
+
+#endif // DISTRIBUTED_SSSP_HPP
@@ -0,0 +1,108 @@
+#pragma once
+#include <cstddef>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Branch-free dominance tests for fixed objective counts. With AVX2 one
+// compare + movemask pair decides a whole vector (K = 2 checks two front
+// members per register, K = 8 uses two registers); otherwise a scalar loop
+// with the same semantics is used. Vectors are row-major, K doubles each.
+namespace Pareto {
+namespace simd {
+
+    // a dominates b: a <= b everywhere and a < b somewhere
+    template <size_t K>
+    inline bool dominates(const double* a, const double* b) {
+#if defined(__AVX2__)
+        if constexpr (K == 2) {
+            __m128d va = _mm_loadu_pd(a), vb = _mm_loadu_pd(b);
+            int le = _mm_movemask_pd(_mm_cmp_pd(va, vb, _CMP_LE_OQ));
+            int lt = _mm_movemask_pd(_mm_cmp_pd(va, vb, _CMP_LT_OQ));
+            return le == 0x3 && lt != 0;
+        } else if constexpr (K == 3) {
+            // Lane 3 is masked to 0 on both sides: always <=, never <
+            const __m256i mask = _mm256_setr_epi64x(-1, -1, -1, 0);
+            __m256d va = _mm256_maskload_pd(a, mask), vb = _mm256_maskload_pd(b, mask);
+            int le = _mm256_movemask_pd(_mm256_cmp_pd(va, vb, _CMP_LE_OQ));
+            int lt = _mm256_movemask_pd(_mm256_cmp_pd(va, vb, _CMP_LT_OQ));
+            return le == 0xF && lt != 0;
+        } else if constexpr (K == 4) {
+            __m256d va = _mm256_loadu_pd(a), vb = _mm256_loadu_pd(b);
+            int le = _mm256_movemask_pd(_mm256_cmp_pd(va, vb, _CMP_LE_OQ));
+            int lt = _mm256_movemask_pd(_mm256_cmp_pd(va, vb, _CMP_LT_OQ));
+            return le == 0xF && lt != 0;
+        } else if constexpr (K == 8) {
+            __m256d a0 = _mm256_loadu_pd(a), b0 = _mm256_loadu_pd(b);
+            __m256d a1 = _mm256_loadu_pd(a + 4), b1 = _mm256_loadu_pd(b + 4);
+            int le = _mm256_movemask_pd(_mm256_cmp_pd(a0, b0, _CMP_LE_OQ)) &
+                     _mm256_movemask_pd(_mm256_cmp_pd(a1, b1, _CMP_LE_OQ));
+            int lt = _mm256_movemask_pd(_mm256_cmp_pd(a0, b0, _CMP_LT_OQ)) |
+                     _mm256_movemask_pd(_mm256_cmp_pd(a1, b1, _CMP_LT_OQ));
+            return le == 0xF && lt != 0;
+        }
+#endif
+        bool all_le = true, any_lt = false;
+        for (size_t i = 0; i < K; ++i) {
+            all_le &= a[i] <= b[i];
+            any_lt |= a[i] < b[i];
+        }
+        return all_le && any_lt;
+    }
+
+    // True if any of the `count` vectors in `block` dominates `candidate`
+    template <size_t K>
+    inline bool dominated_by_any(const double* block, size_t count, const double* candidate) {
+        size_t i = 0;
+#if defined(__AVX2__)
+        if constexpr (K == 2) {
+            // Two front members per register against a duplicated candidate
+            __m256d vc = _mm256_broadcast_pd(reinterpret_cast<const __m128d*>(candidate));
+            for (; i + 2 <= count; i += 2) {
+                __m256d vb = _mm256_loadu_pd(block + i * 2);
+                int le = _mm256_movemask_pd(_mm256_cmp_pd(vb, vc, _CMP_LE_OQ));
+                int lt = _mm256_movemask_pd(_mm256_cmp_pd(vb, vc, _CMP_LT_OQ));
+                if (((le & 0x3) == 0x3 && (lt & 0x3)) || ((le & 0xC) == 0xC && (lt & 0xC))) {
+                    return true;
+                }
+            }
+        }
+#endif
+        for (; i < count; ++i) {
+            if (dominates<K>(block + i * K, candidate)) return true;
+        }
+        return false;
+    }
+
+    // Runtime-K entry points; other K fall back to a scalar loop
+    inline bool dominates(const double* a, const double* b, size_t k) {
+        switch (k) {
+            case 2: return dominates<2>(a, b);
+            case 3: return dominates<3>(a, b);
+            case 4: return dominates<4>(a, b);
+            case 8: return dominates<8>(a, b);
+        }
+        bool at_least_one_better = false;
+        for (size_t i = 0; i < k; ++i) {
+            if (a[i] > b[i]) return false;
+            if (a[i] < b[i]) at_least_one_better = true;
+        }
+        return at_least_one_better;
+    }
+
+    inline bool dominated_by_any(const double* block, size_t count, const double* candidate, size_t k) {
+        switch (k) {
+            case 2: return dominated_by_any<2>(block, count, candidate);
+            case 3: return dominated_by_any<3>(block, count, candidate);
+            case 4: return dominated_by_any<4>(block, count, candidate);
+            case 8: return dominated_by_any<8>(block, count, candidate);
+        }
+        for (size_t i = 0; i < count; ++i) {
+            if (dominates(block + i * k, candidate, k)) return true;
+        }
+        return false;
+    }
+
+} // namespace simd
+} // namespace Pareto
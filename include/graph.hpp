@@ -6,6 +6,7 @@
 #include <unordered_map>
 #include <metis.h>
 #include <limits>
+#include <cstdint>
 
 class DynamicGraph {
 public:
@@ -47,6 +48,36 @@ public:
         
         resize_if_needed(std::max(src, tgt));
         adj[src].push_back({tgt, weights});
+        count_weights(weights, 1);
+        ++revision;
+    }
+
+    // Add the edge, or overwrite the weights of an existing src->tgt edge
+    void set_edge(int src, int tgt, const std::vector<double>& weights) {
+        if (src < 0 || tgt < 0) throw std::invalid_argument("Node IDs must be non-negative");
+        if (weights.empty()) throw std::invalid_argument("Edge must have at least one weight");
+
+        if (src < adj.size()) {
+            for (auto& edge : adj[src]) {
+                if (edge.target == tgt) {
+                    count_weights(edge.weights, -1);
+                    edge.weights = weights;
+                    count_weights(weights, 1);
+                    ++revision;
+                    return;
+                }
+            }
+        }
+        add_edge(src, tgt, weights);
+    }
+
+    // Find an edge (nullptr if absent)
+    const Edge* find_edge(int src, int tgt) const {
+        if (src < 0 || src >= adj.size()) return nullptr;
+        for (const auto& edge : adj[src]) {
+            if (edge.target == tgt) return &edge;
+        }
+        return nullptr;
     }
 
     // Remove edge
@@ -54,8 +85,11 @@ public:
         if (src >= adj.size() || tgt >= adj.size()) return;
         
         auto& edges = adj[src];
-        edges.erase(std::remove_if(edges.begin(), edges.end(),
-            [tgt](const Edge& e) { return e.target == tgt; }), edges.end());
+        auto removed = std::remove_if(edges.begin(), edges.end(),
+            [tgt](const Edge& e) { return e.target == tgt; });
+        for (auto it = removed; it != edges.end(); ++it) count_weights(it->weights, -1);
+        if (removed != edges.end()) ++revision;
+        edges.erase(removed, edges.end());
     }
 
     // Get edges from a node
@@ -89,6 +123,29 @@ public:
         return count;
     }
 
+    // Declare that weights[objective] are multiples of `quantum` (e.g. 0.1 for
+    // deciseconds) so integer queues can be used; 0 drops the declaration.
+    // Weights that are not multiples are rounded to the nearest one.
+    void set_weight_quantum(size_t objective, double quantum) {
+        if (quantum < 0) throw std::invalid_argument("Weight quantum must be non-negative");
+        if (objective >= weight_quanta.size()) weight_quanta.resize(objective + 1, 0.0);
+        weight_quanta[objective] = quantum;
+    }
+
+    // Integer step of weights[objective]: the declared quantum, else 1 if every
+    // weight is a small non-negative integer, else 0 (not quantized)
+    double get_weight_quantum(size_t objective) const {
+        if (objective < weight_quanta.size() && weight_quanta[objective] > 0) {
+            return weight_quanta[objective];
+        }
+        bool integral = objective >= non_integral_weights.size() || non_integral_weights[objective] == 0;
+        return integral ? 1.0 : 0.0;
+    }
+
+    // Bumped by every node or edge change, so data derived from the graph
+    // (e.g. a reversed copy) can tell when it is stale
+    uint64_t get_revision() const { return revision; }
+
     // Backward compatibility
     size_t size() const { return node_count(); }
 
@@ -174,6 +231,22 @@ public:
         return subgraph;
     }
 
+    // Same nodes with every edge src->tgt turned into tgt->src (weights kept),
+    // e.g. for backward searches towards a target
+    DynamicGraph reversed() const {
+        DynamicGraph rev(node_count());
+        for (size_t src = 0; src < adj.size(); ++src) {
+            for (const auto& edge : adj[src]) {
+                rev.add_edge(edge.target, src, edge.weights);
+            }
+        }
+        return rev;
+    }
+
+    // Load a whitespace-separated edge list: "src tgt w1 [w2 ...]" per line,
+    // blank lines and lines starting with '#' are skipped
+    static DynamicGraph load_edge_list(const std::string& path);
+
     void clear() {
         adj.clear();
         node_data.clear();
@@ -181,8 +254,15 @@ public:
         xadj_metis.clear();
         adjncy_metis.clear();
         weights_metis.clear();
+        non_integral_weights.clear();
+        weight_quanta.clear();
+        ++revision;
     }
 
+    // Largest weight get_weight_quantum() treats as integral, so path sums of
+    // up to 2^21 edges stay exact in both double and uint64_t
+    static constexpr double MAX_INTEGRAL_WEIGHT = 4294967296.0;
+
 private:
     std::vector<std::vector<Edge>> adj;
     std::vector<NodeData> node_data;
@@ -192,12 +272,28 @@ private:
     std::vector<idx_t> adjncy_metis;
     std::vector<idx_t> weights_metis;
 
+    // Per objective: edges whose weight is not an integer in [0, MAX_INTEGRAL_WEIGHT]
+    std::vector<size_t> non_integral_weights;
+    std::vector<double> weight_quanta;
+    uint64_t revision = 0;
+
+    void count_weights(const std::vector<double>& weights, int delta) {
+        if (weights.size() > non_integral_weights.size()) non_integral_weights.resize(weights.size(), 0);
+        for (size_t i = 0; i < weights.size(); ++i) {
+            double w = weights[i];
+            if (!(w >= 0 && w <= MAX_INTEGRAL_WEIGHT && w == static_cast<double>(static_cast<uint64_t>(w)))) {
+                non_integral_weights[i] += delta;
+            }
+        }
+    }
+
     void resize_if_needed(int max_node) {
         if (max_node >= adj.size()) {
             adj.resize(max_node + 1);
         }
         if (max_node >= node_data.size()) {
             node_data.resize(max_node + 1);
+            ++revision;
         }
         if (max_node >= partitions.size()) {
             partitions.resize(max_node + 1, -1);
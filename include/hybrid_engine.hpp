@@ -3,12 +3,42 @@
 #include <atomic>
 #include <vector>
 #include <omp.h>
+#include <mpi.h>
 
 class HybridEngine {
     DynamicGraph& graph;
     std::vector<std::atomic<double>> atomic_distances;
     std::vector<int> predecessors;
 
+    // Static halo exchange pattern for one owner map. A cross edge u -> t
+    // (u owned here, t elsewhere) feeds slot `slot` of the buffer for the
+    // rank owning t; slots hold (distance, predecessor) pairs.
+    struct CrossEdge {
+        int u;
+        double weight;
+        int slot;
+    };
+
+    struct HaloPlan {
+        int rank = -1;
+        std::vector<int> owner;
+        std::vector<int> owned;
+        std::vector<int> send_ranks;
+        std::vector<std::vector<int>> send_targets;  // per send rank, sorted
+        std::vector<std::vector<CrossEdge>> cross_edges;
+        std::vector<int> recv_ranks;
+        std::vector<std::vector<int>> recv_targets;  // per recv rank, sender's order
+    };
+
+    HaloPlan halo;
+    int distributed_iterations = 0;
+    bool thread_multiple = false;
+    bool multiple_active = false;
+
+    void build_halo(const std::vector<int>& owner, MPI_Comm comm);
+    bool relax_interior(std::vector<MPI_Request>& pending);
+    bool lower_distance(int node, double dist, int pred);
+
 public:
     explicit HybridEngine(DynamicGraph& g);
     
@@ -20,4 +50,21 @@ public:
 
     // Get path predecessors
     const std::vector<int>& get_predecessors() const;
+
+    // Collective: SSSP over a partitioned graph, each rank relaxing the nodes
+    // with owner[v] == rank (the local partition is enough). Every iteration
+    // posts the boundary halo with MPI_Isend/MPI_Irecv, sweeps the interior
+    // while it is in flight and applies the received boundary values after
+    // MPI_Waitall. Only owned nodes' distances are final on each rank.
+    void compute_distributed(int source, const std::vector<int>& owner, MPI_Comm comm = MPI_COMM_WORLD);
+
+    // Halo iterations of the last compute_distributed
+    int get_distributed_iterations() const { return distributed_iterations; }
+
+    // Let OpenMP threads post and complete their own halo messages. Only
+    // takes effect when MPI was initialized with MPI_THREAD_MULTIPLE;
+    // otherwise compute_distributed keeps all MPI calls on the master thread.
+    void set_thread_multiple(bool enabled) { thread_multiple = enabled; }
+    // Whether the last compute_distributed actually ran in that mode
+    bool uses_thread_multiple() const { return multiple_active; }
 };
\ No newline at end of file
@@ -0,0 +1,140 @@
+#pragma once
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include <algorithm>
+
+// Priority queues of (distance, node) for Dijkstra-style searches. Both share
+// one interface so engines can take the queue as a policy:
+//   push(node, key)  queue node, or lower its key
+//   pop()            (key, node) with the smallest key
+// Callers keep skipping pops whose key is above the node's distance; with the
+// indexed heap that never happens in a sequential search.
+
+// Indexed d-ary min-heap with decrease-key. Each node is queued at most once,
+// so the heap holds at most N entries; a 4-ary layout halves the depth of a
+// binary heap and keeps a node's children in one cache line.
+template <int Arity = 4>
+class IndexedDaryHeap {
+    static_assert(Arity >= 2, "Heap arity must be at least 2");
+
+    std::vector<std::pair<double, int>> entries;  // (key, node)
+    std::vector<int> position;                    // node -> index in entries, -1 if absent
+
+    void place(size_t i, const std::pair<double, int>& entry) {
+        entries[i] = entry;
+        position[entry.second] = static_cast<int>(i);
+    }
+
+    void sift_up(size_t i) {
+        const std::pair<double, int> entry = entries[i];
+        while (i > 0) {
+            size_t parent = (i - 1) / Arity;
+            if (entries[parent].first <= entry.first) break;
+            place(i, entries[parent]);
+            i = parent;
+        }
+        place(i, entry);
+    }
+
+    void sift_down(size_t i) {
+        const std::pair<double, int> entry = entries[i];
+        const size_t n = entries.size();
+        while (true) {
+            size_t first = i * Arity + 1;
+            if (first >= n) break;
+            size_t best = first;
+            const size_t last = first + Arity < n ? first + Arity : n;
+            for (size_t c = first + 1; c < last; ++c) {
+                if (entries[c].first < entries[best].first) best = c;
+            }
+            if (entries[best].first >= entry.first) break;
+            place(i, entries[best]);
+            i = best;
+        }
+        place(i, entry);
+    }
+
+public:
+    // Size the position index for node ids below n (push also grows it)
+    void reserve_nodes(size_t n) {
+        if (position.size() < n) position.resize(n, -1);
+    }
+
+    // Insert node, or decrease its key. Returns false if it was already
+    // queued with a key no larger than `key`.
+    bool push(int node, double key) {
+        if (static_cast<size_t>(node) >= position.size()) position.resize(node + 1, -1);
+        int pos = position[node];
+        if (pos >= 0) {
+            if (entries[pos].first <= key) return false;
+            entries[pos].first = key;
+            sift_up(pos);
+            return true;
+        }
+        entries.emplace_back(key, node);
+        sift_up(entries.size() - 1);
+        return true;
+    }
+
+    const std::pair<double, int>& top() const { return entries.front(); }
+
+    std::pair<double, int> pop() {
+        std::pair<double, int> top = entries.front();
+        position[top.second] = -1;
+        if (entries.size() > 1) {
+            entries.front() = entries.back();
+            entries.pop_back();
+            sift_down(0);
+        } else {
+            entries.pop_back();
+        }
+        return top;
+    }
+
+    bool contains(int node) const {
+        return node >= 0 && static_cast<size_t>(node) < position.size() && position[node] >= 0;
+    }
+
+    bool empty() const { return entries.empty(); }
+    size_t size() const { return entries.size(); }
+
+    // Drop the remaining entries; cost is proportional to them, not to N
+    void clear() {
+        for (const auto& entry : entries) position[entry.second] = -1;
+        entries.clear();
+    }
+};
+
+// Binary heap with lazy deletion: every push adds an entry and stale ones are
+// skipped by the caller, so the heap can grow to O(E). Kept as a policy for
+// comparison and for searches that do not know N up front.
+class LazyBinaryHeap {
+    std::vector<std::pair<double, int>> entries;
+
+    static bool later(const std::pair<double, int>& a, const std::pair<double, int>& b) {
+        return a > b;
+    }
+
+public:
+    void reserve_nodes(size_t) {}
+
+    bool push(int node, double key) {
+        entries.emplace_back(key, node);
+        std::push_heap(entries.begin(), entries.end(), later);
+        return true;
+    }
+
+    const std::pair<double, int>& top() const { return entries.front(); }
+
+    std::pair<double, int> pop() {
+        std::pop_heap(entries.begin(), entries.end(), later);
+        std::pair<double, int> top = entries.back();
+        entries.pop_back();
+        return top;
+    }
+
+    bool empty() const { return entries.empty(); }
+    size_t size() const { return entries.size(); }
+    void clear() { entries.clear(); }
+};
@@ -0,0 +1,118 @@
+#pragma once
+#include "graph.hpp"
+#include "query_pool.hpp"
+#include "path_result.hpp"
+#include <omp.h>
+#include <vector>
+#include <set>
+#include <queue>
+#include <limits>
+#include <algorithm>
+#include <functional>
+
+// K shortest loopless paths on one objective (Yen's algorithm with Lawler's
+// rule: a path only spawns spurs at or after the node where it deviated from
+// its parent). The spur searches of one round are independent and run in
+// parallel, each thread with its own QueryContext and GraphMask, so root-path
+// nodes and used edges are hidden without copying the graph.
+class KShortestPaths {
+    const DynamicGraph& graph;
+    size_t objective;
+    std::vector<QueryContext> contexts;
+    std::vector<GraphMask> masks;
+
+    struct Candidate {
+        double cost;
+        std::vector<int> nodes;
+        size_t deviation;  // index of the spur node in `nodes`
+
+        bool operator>(const Candidate& other) const {
+            if (cost != other.cost) return cost > other.cost;
+            return nodes > other.nodes;
+        }
+    };
+
+public:
+    explicit KShortestPaths(const DynamicGraph& g, size_t objective_index = 0,
+                            int num_threads = omp_get_max_threads())
+        : graph(g), objective(objective_index),
+          contexts(std::max(1, num_threads)), masks(std::max(1, num_threads)) {}
+
+    // Up to k loopless source -> target paths by increasing cost (ties by node
+    // sequence). objectives[0] holds the path cost on the chosen objective.
+    std::vector<PathResult> compute(int source, int target, size_t k) {
+        const double INF = std::numeric_limits<double>::max();
+        std::vector<PathResult> accepted;
+        const int n = graph.node_count();
+        if (k == 0 || source < 0 || source >= n || target < 0 || target >= n) return accepted;
+
+        double dist = contexts[0].run(graph, source, target, objective);
+        if (dist == INF) return accepted;
+        accepted.push_back({contexts[0].get_path(target), {dist}});
+        std::vector<size_t> deviations{0};
+
+        std::priority_queue<Candidate, std::vector<Candidate>, std::greater<>> candidates;
+        std::set<std::vector<int>> seen{accepted[0].nodes};
+
+        while (accepted.size() < k) {
+            const std::vector<int>& last = accepted.back().nodes;
+            const std::vector<double> prefix = prefix_costs(last);
+            const long first_spur = static_cast<long>(deviations.back());
+            const long spurs = static_cast<long>(last.size()) - 1;
+
+            std::vector<Candidate> found(std::max(0L, spurs - first_spur));
+            #pragma omp parallel for schedule(dynamic, 1) num_threads(contexts.size())
+            for (long i = first_spur; i < spurs; ++i) {
+                QueryContext& ctx = contexts[omp_get_thread_num()];
+                GraphMask& mask = masks[omp_get_thread_num()];
+                mask.clear();
+
+                // Root path nodes other than the spur node are off limits
+                for (long r = 0; r < i; ++r) mask.block_node(last[r]);
+                // So are the next edges of accepted paths sharing this root
+                for (const auto& path : accepted) {
+                    if (static_cast<long>(path.nodes.size()) > i + 1 &&
+                        std::equal(last.begin(), last.begin() + i + 1, path.nodes.begin())) {
+                        mask.block_edge(path.nodes[i], path.nodes[i + 1]);
+                    }
+                }
+
+                double spur_dist = ctx.run(graph, last[i], target, objective, &mask);
+                if (spur_dist == INF) continue;
+
+                Candidate& cand = found[i - first_spur];
+                cand.cost = prefix[i] + spur_dist;
+                cand.nodes.assign(last.begin(), last.begin() + i);
+                std::vector<int> spur = ctx.get_path(target);
+                cand.nodes.insert(cand.nodes.end(), spur.begin(), spur.end());
+                cand.deviation = static_cast<size_t>(i);
+            }
+
+            for (auto& cand : found) {
+                if (cand.nodes.empty() || !seen.insert(cand.nodes).second) continue;
+                candidates.push(std::move(cand));
+            }
+            if (candidates.empty()) break;
+
+            Candidate best = candidates.top();
+            candidates.pop();
+            accepted.push_back({std::move(best.nodes), {best.cost}});
+            deviations.push_back(best.deviation);
+        }
+        return accepted;
+    }
+
+private:
+    // prefix[i] = cost of path[0..i], taking the cheapest parallel edge
+    std::vector<double> prefix_costs(const std::vector<int>& path) const {
+        std::vector<double> prefix(path.size(), 0.0);
+        for (size_t h = 0; h + 1 < path.size(); ++h) {
+            double best = std::numeric_limits<double>::max();
+            for (const auto& edge : graph.get_edges(path[h])) {
+                if (edge.target == path[h + 1]) best = std::min(best, edge.weights[objective]);
+            }
+            prefix[h + 1] = prefix[h] + best;
+        }
+        return prefix;
+    }
+};
@@ -0,0 +1,57 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Objective vectors of MOSP labels are stored inline, up to this many
+constexpr size_t MAX_LABEL_OBJECTIVES = 8;
+
+// One partial path of a label-setting search. The path itself is only the
+// chain of parent indices; nodes are materialized for the final front.
+struct Label {
+    double objs[MAX_LABEL_OBJECTIVES];
+    int32_t cell[MAX_LABEL_OBJECTIVES];  // epsilon grid cell, unused when exact
+    int node;
+    int parent;                          // label index, -1 at the source
+    bool dead;                           // dominated while still queued
+};
+
+// Bump allocator for labels, addressed by index. Labels live in fixed-size
+// chunks that are never moved or freed until destruction, so indices stay
+// valid while the arena grows and reset() makes the next query reuse the
+// same memory without touching the allocator.
+class LabelArena {
+public:
+    static constexpr size_t CHUNK_BITS = 12;
+    static constexpr size_t CHUNK_SIZE = size_t(1) << CHUNK_BITS;
+
+    // Index of a new, uninitialized label
+    int allocate() {
+        if (used == chunks.size() * CHUNK_SIZE) {
+            chunks.emplace_back(new Label[CHUNK_SIZE]);
+        }
+        return static_cast<int>(used++);
+    }
+
+    Label& operator[](int id) {
+        return chunks[static_cast<size_t>(id) >> CHUNK_BITS][static_cast<size_t>(id) & (CHUNK_SIZE - 1)];
+    }
+
+    const Label& operator[](int id) const {
+        return chunks[static_cast<size_t>(id) >> CHUNK_BITS][static_cast<size_t>(id) & (CHUNK_SIZE - 1)];
+    }
+
+    // Give back the most recent allocation (a rejected candidate)
+    void release_last() { --used; }
+
+    // Forget all labels but keep the chunks
+    void reset() { used = 0; }
+
+    size_t size() const { return used; }
+    size_t chunk_count() const { return chunks.size(); }
+
+private:
+    std::vector<std::unique_ptr<Label[]>> chunks;
+    size_t used = 0;
+};
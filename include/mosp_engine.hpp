@@ -3,62 +3,646 @@
 #include "sosp_engine.hpp"
 #include "pareto_utils.hpp"
 #include "path_result.hpp"
+#include "label_arena.hpp"
 #include <omp.h>
+#include <limits>
+#include <unordered_map>
+#include <cstdint>
+#include <cmath>
+#include <stdexcept>
+#include <chrono>
+#include <functional>
 
 class MOSPEngine {
+public:
+    using Clock = std::chrono::steady_clock;
+
+private:
     DynamicGraph& graph;
     std::vector<SOSPEngine> sosp_engines;
     std::vector<size_t> weight_indices;
 
+    // Ensemble state kept between compute_ensemble() and update()
+    DynamicGraph ensemble;
+    SOSPEngine ensemble_engine;
+    std::unordered_map<uint64_t, int> edge_counts;     // trees using edge u->v
+    std::vector<std::vector<int>> tree_predecessors;   // per-objective snapshot
+    int ensemble_source = -1;
+
+    // Label-setting state, reused across queries so steady-state searches do
+    // not allocate: labels live in the arena, per-node lists keep capacity
+    LabelArena arena;
+    std::vector<std::vector<int>> node_labels;  // live labels per node
+    std::vector<int> labeled_nodes;             // nodes with a non-empty list
+    std::vector<int> label_heap;
+    std::vector<int> target_labels;             // in pop order
+
+    // Reverse SOSP bounds of compute_constrained, reused while the graph
+    // revision and the target stay the same
+    DynamicGraph reverse;
+    std::vector<SOSPEngine> reverse_engines;
+    uint64_t reverse_revision = 0;
+    int bounds_target = -1;
+
 public:
     explicit MOSPEngine(DynamicGraph& g, 
                        const std::vector<size_t>& indices = {0})
-        : graph(g), weight_indices(indices) {
+        : graph(g), weight_indices(indices), ensemble_engine(ensemble) {
         for (auto idx : indices) {
-            sosp_engines.emplace_back(g);
+            sosp_engines.emplace_back(g, ObjectiveWeight{idx});
+            reverse_engines.emplace_back(reverse, ObjectiveWeight{idx});
         }
     }
 
+    // ensemble_engine and reverse_engines refer to members
+    MOSPEngine(const MOSPEngine&) = delete;
+    MOSPEngine& operator=(const MOSPEngine&) = delete;
+
+    // Exact Pareto front from source to target
     std::vector<PathResult> compute_pareto(int source, int target) {
+        return compute_label_setting(source, target);
+    }
+
+    // Label-setting MOSP (multi-objective Dijkstra). Labels are popped in
+    // lexicographic order, so a popped label is final; labels dominated at
+    // their node or by a label already at the target are dropped.
+    //
+    // epsilon > 0 gives an approximate front with bounded label counts: each
+    // objective is bucketed on a grid of base (1 + epsilon) and a node keeps
+    // at most one label per cell. Every Pareto-optimal path of h hops is then
+    // covered by a returned path within a factor (1 + epsilon)^h in each
+    // objective, and a node holds at most (log_{1+eps}(max/min) + 1)^K labels.
+    std::vector<PathResult> compute_label_setting(int source, int target, double epsilon = 0.0) {
+        label_search(source, target, epsilon, nullptr, Clock::time_point::max());
+        return materialize(target_labels);
+    }
+
+    // Called with each final Pareto path; return false to stop the search
+    using ParetoCallback = std::function<bool(const PathResult&)>;
+
+    // Streaming label-setting: `on_path` receives every target path as soon
+    // as it is settled, i.e. proven Pareto-optimal, in lexicographic order.
+    // Stops early when the callback returns false or `deadline` passes.
+    // Returns true if the search ran to completion (all paths were emitted).
+    bool stream_pareto(int source, int target, const ParetoCallback& on_path,
+                       Clock::time_point deadline = Clock::time_point::max(), double epsilon = 0.0) {
+        return label_search(source, target, epsilon, &on_path, deadline);
+    }
+
+    // Anytime front: the exact front if the search finishes before
+    // `deadline`, otherwise the paths settled so far followed by the target
+    // paths still queued that nothing found so far dominates.
+    std::vector<PathResult> compute_pareto_until(int source, int target, Clock::time_point deadline,
+                                                 bool* complete = nullptr, double epsilon = 0.0) {
+        bool done = label_search(source, target, epsilon, nullptr, deadline);
+        if (complete) *complete = done;
+
+        std::vector<int> ids = target_labels;
+        if (!done) {
+            std::vector<int> settled(target_labels);
+            std::sort(settled.begin(), settled.end());
+            for (int id : node_labels[target]) {
+                if (!std::binary_search(settled.begin(), settled.end(), id)) ids.push_back(id);
+            }
+            // Tentative paths in lexicographic order after the settled ones
+            std::sort(ids.begin() + target_labels.size(), ids.end(), [&](int a, int b) {
+                return std::lexicographical_compare(arena[a].objs, arena[a].objs + weight_indices.size(),
+                                                    arena[b].objs, arena[b].objs + weight_indices.size());
+            });
+        }
+        return materialize(ids);
+    }
+
+    // Labels kept by the last label-setting search
+    size_t get_label_count() const { return arena.size(); }
+
+    // Memory chunks held by the label arena
+    size_t get_arena_chunks() const { return arena.chunk_count(); }
+
+    // Resource-constrained query: minimize objective `primary` (a position in
+    // the engine's objective list) subject to objs[i] <= bounds[i] for every
+    // other i; use infinity for unconstrained objectives. Lower bounds from
+    // one reverse SOSP per objective drive an A* search on the primary
+    // objective and prune labels that can no longer meet a bound, so the
+    // first label settled at the target is optimal and the front is never
+    // built. Returns an empty path with infinite objectives if infeasible.
+    PathResult compute_constrained(int source, int target, size_t primary,
+                                   const std::vector<double>& bounds) {
+        const int n = graph.node_count();
+        const size_t K = weight_indices.size();
+        if (primary >= K) throw std::invalid_argument("Primary objective out of range");
+        if (bounds.size() != K) throw std::invalid_argument("Need one bound per objective");
+        if (K > MAX_LABEL_OBJECTIVES) throw std::invalid_argument("Too many objectives for label-setting");
+        if (source < 0 || source >= n || target < 0 || target >= n) return make_result({});
+
+        // Lower bounds to the target, one reverse SOSP per objective
+        if (bounds_target < 0 || reverse_revision != graph.get_revision()) {
+            reverse = graph.reversed();
+            reverse_revision = graph.get_revision();
+            bounds_target = -1;
+        }
+        if (bounds_target != target) {
+            #pragma omp parallel for
+            for (size_t i = 0; i < K; ++i) {
+                reverse_engines[i].compute(target);
+            }
+            bounds_target = target;
+        }
+        auto lower_bound = [&](int node, size_t i) { return reverse_engines[i].get_all_distances()[node]; };
+
+        auto feasible = [&](const double* objs, int node) {
+            for (size_t i = 0; i < K; ++i) {
+                double h = lower_bound(node, i);
+                if (h == std::numeric_limits<double>::max() || (i != primary && objs[i] + h > bounds[i])) {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        reset_labels(n);
+
+        // A* order on the primary objective, remaining objectives break ties
+        auto later = [&](int a, int b) {
+            const Label& la = arena[a];
+            const Label& lb = arena[b];
+            double fa = la.objs[primary] + lower_bound(la.node, primary);
+            double fb = lb.objs[primary] + lower_bound(lb.node, primary);
+            if (fa != fb) return fa > fb;
+            for (size_t i = 0; i < K; ++i) {
+                if (la.objs[i] != lb.objs[i]) return la.objs[i] > lb.objs[i];
+            }
+            return a > b;
+        };
+
+        int root = arena.allocate();
+        arena[root].node = source;
+        arena[root].parent = -1;
+        arena[root].dead = false;
+        std::fill_n(arena[root].objs, K, 0.0);
+        if (!feasible(arena[root].objs, source)) return make_result({});
+        add_live_label(source, root);
+        label_heap.push_back(root);
+
+        while (!label_heap.empty()) {
+            std::pop_heap(label_heap.begin(), label_heap.end(), later);
+            int id = label_heap.back();
+            label_heap.pop_back();
+            if (arena[id].dead) continue;
+
+            if (arena[id].node == target) {
+                PathResult result;
+                result.objectives.assign(arena[id].objs, arena[id].objs + K);
+                for (int l = id; l != -1; l = arena[l].parent) result.nodes.push_back(arena[l].node);
+                std::reverse(result.nodes.begin(), result.nodes.end());
+                return result;
+            }
+
+            for (const auto& edge : graph.get_edges(arena[id].node)) {
+                const int v = edge.target;
+                int cand = arena.allocate();
+                Label& label = arena[cand];
+                const Label& parent = arena[id];
+                for (size_t i = 0; i < K; ++i) {
+                    label.objs[i] = parent.objs[i] + edge.weights[weight_indices[i]];
+                }
+                label.node = v;
+                label.parent = id;
+                label.dead = false;
+
+                bool rejected = !feasible(label.objs, v);
+                for (size_t l = 0; l < node_labels[v].size() && !rejected; ++l) {
+                    rejected = covers(arena[node_labels[v][l]].objs, label.objs, K);
+                }
+                if (rejected) {
+                    arena.release_last();
+                    continue;
+                }
+
+                auto& live = node_labels[v];
+                live.erase(std::remove_if(live.begin(), live.end(), [&](int other) {
+                    Label& existing = arena[other];
+                    if (!Pareto::dominates(label.objs, existing.objs, K)) return false;
+                    existing.dead = true;
+                    return true;
+                }), live.end());
+
+                add_live_label(v, cand);
+                label_heap.push_back(cand);
+                std::push_heap(label_heap.begin(), label_heap.end(), later);
+            }
+        }
+        return make_result({});
+    }
+
+    // Weighted-sum sweep: for every preference vector (one weight per
+    // objective, non-negative) the path minimizing sum_i w_i * objs[i].
+    // All vectors are solved by one label-correcting traversal: each node
+    // carries a lane of distances per vector, relaxed together in a SIMD loop,
+    // and a node is queued under the smallest lane that improved. Each result
+    // is a supported Pareto point; results are in the order of the vectors
+    // (empty path with infinite objectives where the target is unreachable).
+    std::vector<PathResult> compute_weighted_sums(int source, int target,
+                                                  const std::vector<std::vector<double>>& preferences) {
+        const double INF = std::numeric_limits<double>::max();
+        const int n = graph.node_count();
+        const size_t K = weight_indices.size();
+        const size_t L = preferences.size();
+        for (const auto& pref : preferences) {
+            if (pref.size() != K) throw std::invalid_argument("Need one weight per objective");
+            for (double w : pref) {
+                if (!(w >= 0.0)) throw std::invalid_argument("Preference weights must be non-negative");
+            }
+        }
+        if (L == 0) return {};
+        if (source < 0 || source >= n || target < 0 || target >= n) {
+            return std::vector<PathResult>(L, make_result({}));
+        }
+
+        // Objective-major weights so the lane loop reads them contiguously
+        std::vector<double> lane_weights(K * L);
+        for (size_t l = 0; l < L; ++l) {
+            for (size_t i = 0; i < K; ++i) lane_weights[i * L + l] = preferences[l][i];
+        }
+
+        std::vector<double> dist(static_cast<size_t>(n) * L, INF);
+        std::vector<int> pred(static_cast<size_t>(n) * L, -1);
+        std::vector<double> queued_key(n, INF);   // key of the live heap entry
+        std::vector<double> edge_cost(L);
+        std::vector<std::pair<double, int>> heap;
+
+        std::fill_n(&dist[static_cast<size_t>(source) * L], L, 0.0);
+        queued_key[source] = 0.0;
+        heap.emplace_back(0.0, source);
+
+        while (!heap.empty()) {
+            std::pop_heap(heap.begin(), heap.end(), std::greater<>());
+            auto [key, u] = heap.back();
+            heap.pop_back();
+            if (key != queued_key[u]) continue;
+            queued_key[u] = INF;
+
+            // Lanes only get worse from here: stop once every target lane is final
+            const double* target_dist = &dist[static_cast<size_t>(target) * L];
+            if (key >= *std::max_element(target_dist, target_dist + L)) break;
+
+            const double* du = &dist[static_cast<size_t>(u) * L];
+            for (const auto& edge : graph.get_edges(u)) {
+                std::fill(edge_cost.begin(), edge_cost.end(), 0.0);
+                for (size_t i = 0; i < K; ++i) {
+                    const double w = edge.weights[weight_indices[i]];
+                    const double* lw = &lane_weights[i * L];
+                    #pragma omp simd
+                    for (size_t l = 0; l < L; ++l) edge_cost[l] += lw[l] * w;
+                }
+
+                double* dv = &dist[static_cast<size_t>(edge.target) * L];
+                int* pv = &pred[static_cast<size_t>(edge.target) * L];
+                double improved = INF;
+                #pragma omp simd reduction(min:improved)
+                for (size_t l = 0; l < L; ++l) {
+                    const double candidate = du[l] + edge_cost[l];
+                    const bool better = candidate < dv[l];
+                    dv[l] = better ? candidate : dv[l];
+                    pv[l] = better ? u : pv[l];
+                    improved = better ? std::min(improved, candidate) : improved;
+                }
+
+                if (improved < queued_key[edge.target]) {
+                    queued_key[edge.target] = improved;
+                    heap.emplace_back(improved, edge.target);
+                    std::push_heap(heap.begin(), heap.end(), std::greater<>());
+                }
+            }
+        }
+
+        std::vector<PathResult> results(L);
+        for (size_t l = 0; l < L; ++l) {
+            if (dist[static_cast<size_t>(target) * L + l] == INF) {
+                results[l] = make_result({});
+                continue;
+            }
+            std::vector<int> nodes;
+            for (int v = target; v != -1; v = pred[static_cast<size_t>(v) * L + l]) nodes.push_back(v);
+            std::reverse(nodes.begin(), nodes.end());
+
+            // Objectives along the parallel edge this lane actually used
+            std::vector<double> objs(K, 0.0);
+            for (size_t h = 0; h + 1 < nodes.size(); ++h) {
+                const DynamicGraph::Edge* used = nullptr;
+                double best = INF;
+                for (const auto& edge : graph.get_edges(nodes[h])) {
+                    if (edge.target != nodes[h + 1]) continue;
+                    double cost = 0.0;
+                    for (size_t i = 0; i < K; ++i) cost += lane_weights[i * L + l] * edge.weights[weight_indices[i]];
+                    if (cost < best) {
+                        best = cost;
+                        used = &edge;
+                    }
+                }
+                for (size_t i = 0; i < K; ++i) objs[i] += used->weights[weight_indices[i]];
+            }
+            results[l] = {std::move(nodes), std::move(objs)};
+        }
+        return results;
+    }
+
+    // Heuristic MOSP: one SOSP tree per objective (computed in parallel), an
+    // ensemble graph of their edges weighted by how many trees use each edge
+    // (K - count + 1), and one more SOSP on the ensemble. The resulting
+    // compromise path costs K+1 SSSPs instead of a label-setting search.
+    PathResult compute_ensemble(int source, int target) {
+        const size_t n = graph.node_count();
+
         #pragma omp parallel for
         for (size_t i = 0; i < sosp_engines.size(); ++i) {
             sosp_engines[i].compute(source);
         }
 
-        std::vector<PathResult> all_paths;
-        extract_paths(source, target, {source}, std::vector<double>(weight_indices.size(), 0.0), all_paths);
+        // Count how many trees use each edge
+        edge_counts.clear();
+        tree_predecessors.clear();
+        for (const auto& engine : sosp_engines) {
+            const auto& preds = engine.get_predecessors();
+            for (size_t v = 0; v < n; ++v) {
+                if (preds[v] >= 0) ++edge_counts[edge_key(preds[v], v)];
+            }
+            tree_predecessors.push_back(preds);
+        }
+
+        ensemble = DynamicGraph(n);
+        for (const auto& [key, count] : edge_counts) {
+            ensemble.add_edge(key >> 32, key & 0xffffffffu, {ensemble_weight(count)});
+        }
+
+        ensemble_source = source;
+        ensemble_engine.compute(source);
+        return get_ensemble_path(target);
+    }
 
-        Pareto::filter_dominated(all_paths);
-        return all_paths;
+    // Compromise path to target from the last compute_ensemble/update
+    PathResult get_ensemble_path(int target) const {
+        if (ensemble_source < 0) throw std::logic_error("compute_ensemble has not been called");
+        if (target < 0 || target >= static_cast<int>(ensemble.node_count())) {
+            return make_result({});
+        }
+        return make_result(ensemble_engine.get_path(target));
     }
 
+    const DynamicGraph& get_ensemble_graph() const { return ensemble; }
+
+    // Incremental update after the out-edges of `changed_edges` (tail nodes)
+    // changed in the graph. Each objective tree is repaired in parallel, only
+    // the ensemble edges whose tree counts moved are rewritten, and the
+    // ensemble SOSP is repaired from those edges instead of recomputed.
     void update(const std::vector<int>& changed_edges) {
+        std::vector<std::vector<int>> moved(sosp_engines.size());
+
         #pragma omp parallel for
         for (size_t i = 0; i < sosp_engines.size(); ++i) {
-            sosp_engines[i].update(changed_edges);
+            moved[i] = sosp_engines[i].update(changed_edges);
+        }
+
+        if (ensemble_source < 0) return;
+
+        // Diff the repaired trees against the snapshot
+        std::vector<uint64_t> dirty;
+        for (size_t i = 0; i < sosp_engines.size(); ++i) {
+            const auto& preds = sosp_engines[i].get_predecessors();
+            auto& snapshot = tree_predecessors[i];
+            if (snapshot.size() < preds.size()) snapshot.resize(preds.size(), -1);
+
+            for (int v : moved[i]) {
+                int old_pred = snapshot[v];
+                int new_pred = preds[v];
+                if (old_pred == new_pred) continue;
+
+                if (old_pred >= 0) {
+                    --edge_counts[edge_key(old_pred, v)];
+                    dirty.push_back(edge_key(old_pred, v));
+                }
+                if (new_pred >= 0) {
+                    ++edge_counts[edge_key(new_pred, v)];
+                    dirty.push_back(edge_key(new_pred, v));
+                }
+                snapshot[v] = new_pred;
+            }
+        }
+
+        std::sort(dirty.begin(), dirty.end());
+        dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+
+        std::vector<int> changed_tails;
+        for (uint64_t key : dirty) {
+            int u = key >> 32;
+            int v = key & 0xffffffffu;
+            int count = edge_counts[key];
+            if (count == 0) {
+                ensemble.remove_edge(u, v);
+                edge_counts.erase(key);
+            } else {
+                ensemble.set_edge(u, v, {ensemble_weight(count)});
+            }
+            changed_tails.push_back(u);
+        }
+
+        // Keep the ensemble as large as the graph so every target is valid
+        if (ensemble.node_count() < graph.node_count()) {
+            ensemble.add_node(graph.node_count() - 1);
         }
+
+        ensemble_engine.update(changed_tails);
     }
 
 private:
-    void extract_paths(int u, int target, 
-                      std::vector<int> current_nodes,
-                      std::vector<double> current_objs,
-                      std::vector<PathResult>& paths) {
-        if (u == target) {
-            paths.push_back({current_nodes, current_objs});
-            return;
-        }
-
-        for (const auto& edge : graph.get_edges(u)) {
-            auto new_nodes = current_nodes;
-            new_nodes.push_back(edge.target);
-            
-            auto new_objs = current_objs;
+    static uint64_t edge_key(int u, int v) {
+        return (static_cast<uint64_t>(u) << 32) | static_cast<uint32_t>(v);
+    }
+
+    // Edges shared by more trees are cheaper in the ensemble
+    double ensemble_weight(int count) const {
+        return static_cast<double>(sosp_engines.size() - count + 1);
+    }
+
+    // Objective values of a node sequence on the original graph, taking the
+    // cheapest parallel edge per objective
+    PathResult make_result(const std::vector<int>& nodes) const {
+        const double INF = std::numeric_limits<double>::max();
+        if (nodes.empty()) {
+            return {nodes, std::vector<double>(weight_indices.size(), INF)};
+        }
+
+        std::vector<double> objs(weight_indices.size(), 0.0);
+        for (size_t h = 0; h + 1 < nodes.size(); ++h) {
             for (size_t i = 0; i < weight_indices.size(); ++i) {
-                new_objs[i] += edge.weights[weight_indices[i]];
+                double best = INF;
+                for (const auto& edge : graph.get_edges(nodes[h])) {
+                    if (edge.target == nodes[h + 1]) {
+                        best = std::min(best, edge.weights[weight_indices[i]]);
+                    }
+                }
+                objs[i] += best;
             }
-            
-            extract_paths(edge.target, target, new_nodes, new_objs, paths);
         }
+        return {nodes, objs};
+    }
+
+    // The label-setting loop behind compute_label_setting, stream_pareto and
+    // compute_pareto_until. Settled target labels are collected in
+    // target_labels and passed to `on_path` if given. Returns false if the
+    // callback or the deadline stopped the search early.
+    bool label_search(int source, int target, double epsilon,
+                      const ParetoCallback* on_path, Clock::time_point deadline) {
+        const int n = graph.node_count();
+        const size_t K = weight_indices.size();
+        if (epsilon < 0.0 || std::isnan(epsilon)) throw std::invalid_argument("Epsilon must be non-negative");
+        if (K > MAX_LABEL_OBJECTIVES) throw std::invalid_argument("Too many objectives for label-setting");
+
+        reset_labels(n);
+        if (source < 0 || source >= n || target < 0 || target >= n) return true;
+
+        const bool gridded = epsilon > 0.0;
+        const double log_base = std::log1p(epsilon);
+        auto set_cell = [&](Label& label) {
+            if (!gridded) return;
+            for (size_t i = 0; i < K; ++i) {
+                // Zero costs get their own cell below every positive one
+                double v = label.objs[i];
+                label.cell[i] = v > 0.0 ? static_cast<int32_t>(std::floor(std::log(v) / log_base))
+                                        : std::numeric_limits<int32_t>::min();
+            }
+        };
+
+        // Min-heap on lexicographic objective order, ties by creation order
+        auto later = [&](int a, int b) {
+            const double* oa = arena[a].objs;
+            const double* ob = arena[b].objs;
+            for (size_t i = 0; i < K; ++i) {
+                if (oa[i] != ob[i]) return oa[i] > ob[i];
+            }
+            return a > b;
+        };
+
+        int root = arena.allocate();
+        arena[root].node = source;
+        arena[root].parent = -1;
+        arena[root].dead = false;
+        std::fill_n(arena[root].objs, K, 0.0);
+        set_cell(arena[root]);
+        add_live_label(source, root);
+        label_heap.push_back(root);
+
+        const bool timed = deadline != Clock::time_point::max();
+        size_t pops = 0;
+
+        while (!label_heap.empty()) {
+            // Reading the clock on every pop would dominate small searches
+            if (timed && (++pops & 255) == 0 && Clock::now() >= deadline) return false;
+
+            std::pop_heap(label_heap.begin(), label_heap.end(), later);
+            int id = label_heap.back();
+            label_heap.pop_back();
+            if (arena[id].dead) continue;
+
+            const int u = arena[id].node;
+            if (u == target) {
+                target_labels.push_back(id);
+                if (on_path && !(*on_path)(materialize_one(id))) return false;
+                continue;
+            }
+            if (covered_by_target(arena[id].objs, K)) continue;
+
+            for (const auto& edge : graph.get_edges(u)) {
+                const int v = edge.target;
+
+                // Build the candidate in place; dropping it just returns the slot
+                int cand = arena.allocate();
+                Label& label = arena[cand];
+                const Label& parent = arena[id];
+                for (size_t i = 0; i < K; ++i) {
+                    label.objs[i] = parent.objs[i] + edge.weights[weight_indices[i]];
+                }
+                label.node = v;
+                label.parent = id;
+                label.dead = false;
+                set_cell(label);
+
+                // Reject if an existing label is as good, or shares the cell
+                bool rejected = false;
+                for (int other : node_labels[v]) {
+                    const Label& existing = arena[other];
+                    if (covers(existing.objs, label.objs, K) ||
+                        (gridded && std::equal(existing.cell, existing.cell + K, label.cell) &&
+                         !Pareto::dominates(label.objs, existing.objs, K))) {
+                        rejected = true;
+                        break;
+                    }
+                }
+                if (rejected || covered_by_target(label.objs, K)) {
+                    arena.release_last();
+                    continue;
+                }
+
+                // Drop the labels the new one dominates (or replaces in its cell)
+                auto& live = node_labels[v];
+                live.erase(std::remove_if(live.begin(), live.end(), [&](int other) {
+                    Label& existing = arena[other];
+                    if (!Pareto::dominates(label.objs, existing.objs, K)) return false;
+                    existing.dead = true;
+                    return true;
+                }), live.end());
+
+                add_live_label(v, cand);
+                label_heap.push_back(cand);
+                std::push_heap(label_heap.begin(), label_heap.end(), later);
+            }
+        }
+        return true;
+    }
+
+    // Node sequence and objectives of one label, following parent indices
+    PathResult materialize_one(int id) const {
+        PathResult path;
+        path.objectives.assign(arena[id].objs, arena[id].objs + weight_indices.size());
+        size_t hops = 0;
+        for (int l = id; l != -1; l = arena[l].parent) ++hops;
+        path.nodes.resize(hops);
+        for (int l = id; l != -1; l = arena[l].parent) path.nodes[--hops] = arena[l].node;
+        return path;
+    }
+
+    std::vector<PathResult> materialize(const std::vector<int>& ids) const {
+        std::vector<PathResult> front;
+        front.reserve(ids.size());
+        for (int id : ids) front.push_back(materialize_one(id));
+        return front;
+    }
+
+    // a is at least as good as b in every objective
+    static bool covers(const double* a, const double* b, size_t k) {
+        return std::equal(a, a + k, b) || Pareto::dominates(a, b, k);
+    }
+
+    // A label no better than some path already found to the target
+    bool covered_by_target(const double* objs, size_t k) const {
+        for (int id : target_labels) {
+            if (covers(arena[id].objs, objs, k)) return true;
+        }
+        return false;
+    }
+
+    void add_live_label(int node, int id) {
+        if (node_labels[node].empty()) labeled_nodes.push_back(node);
+        node_labels[node].push_back(id);
+    }
+
+    // Clear the previous query's labels; only the lists it touched are cleared
+    void reset_labels(int n) {
+        arena.reset();
+        if (static_cast<int>(node_labels.size()) < n) node_labels.resize(n);
+        for (int node : labeled_nodes) node_labels[node].clear();
+        labeled_nodes.clear();
+        label_heap.clear();
+        target_labels.clear();
     }
 };
\ No newline at end of file
@@ -16,6 +16,8 @@ public:
     void synchronize_boundaries();
     DynamicGraph& get_local_partition();
     const std::unordered_map<int, std::vector<int>>& get_boundary_nodes() const;
+    // Owning rank of every node after partition_and_distribute()
+    const std::vector<int>& get_node_partitions() const;
     
 private:
     DynamicGraph& original_graph;
@@ -0,0 +1,184 @@
+#pragma once
+#include "graph.hpp"
+#include "indexed_heap.hpp"
+#include <omp.h>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <limits>
+#include <memory>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdint>
+
+// Parallel Dijkstra on a relaxed concurrent priority queue (MultiQueue).
+// Instead of one mutex-protected heap, c*p sequential heaps are guarded by
+// try-locks: a push goes to a random unlocked heap, a pop samples two random
+// heaps and takes the one with the smaller cached top. Pops are only roughly
+// in key order, so a node can be settled more than once; stale entries are
+// dropped when popped.
+//
+// Termination is lock-free: `pending` counts entries that are queued or being
+// expanded. An expansion adds its k children before pushing them and removes
+// itself in the same fetch_add(k - 1), so the counter reaches zero only when
+// no heap holds work and no thread can produce more.
+class MultiQueueSSSP {
+    struct alignas(64) Queue {
+        std::atomic<bool> locked{false};
+        std::atomic<double> top{std::numeric_limits<double>::max()};
+        LazyBinaryHeap heap;
+    };
+
+    const DynamicGraph& graph;
+    size_t objective;
+    int num_threads;
+    size_t queue_count;
+    std::unique_ptr<Queue[]> queues;
+
+    std::unique_ptr<std::atomic<double>[]> distances;
+    std::unique_ptr<std::atomic<bool>[]> node_locks;  // guard distance + predecessor pairs
+    std::vector<int> predecessors;
+    size_t capacity = 0;
+    std::atomic<int64_t> pending{0};
+
+    static uint64_t next_random(uint64_t& state) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    static bool try_lock(std::atomic<bool>& flag) {
+        return !flag.load(std::memory_order_relaxed) &&
+               !flag.exchange(true, std::memory_order_acquire);
+    }
+
+    static void unlock(std::atomic<bool>& flag) { flag.store(false, std::memory_order_release); }
+
+    void push(uint64_t& rng, double key, int node) {
+        while (true) {
+            Queue& q = queues[next_random(rng) % queue_count];
+            if (!try_lock(q.locked)) continue;
+            q.heap.push(node, key);
+            q.top.store(q.heap.top().first, std::memory_order_relaxed);
+            unlock(q.locked);
+            return;
+        }
+    }
+
+    // Pop from the better of two sampled heaps; false if both looked empty
+    // or the chosen one was locked
+    bool try_pop(uint64_t& rng, std::pair<double, int>& item) {
+        Queue* a = &queues[next_random(rng) % queue_count];
+        Queue* b = &queues[next_random(rng) % queue_count];
+        if (b->top.load(std::memory_order_relaxed) < a->top.load(std::memory_order_relaxed)) std::swap(a, b);
+        if (a->top.load(std::memory_order_relaxed) == std::numeric_limits<double>::max()) return false;
+        if (!try_lock(a->locked)) return false;
+
+        bool popped = !a->heap.empty();
+        if (popped) {
+            item = a->heap.pop();
+            a->top.store(a->heap.empty() ? std::numeric_limits<double>::max() : a->heap.top().first,
+                         std::memory_order_relaxed);
+        }
+        unlock(a->locked);
+        return popped;
+    }
+
+    void reset(size_t n) {
+        const double INF = std::numeric_limits<double>::max();
+        // The graph may have grown since the last query
+        if (capacity < n) {
+            distances.reset(new std::atomic<double>[n]);
+            node_locks.reset(new std::atomic<bool>[n]);
+            capacity = n;
+        }
+        predecessors.assign(n, -1);
+        #pragma omp parallel for num_threads(num_threads)
+        for (long v = 0; v < static_cast<long>(n); ++v) {
+            distances[v].store(INF, std::memory_order_relaxed);
+            node_locks[v].store(false, std::memory_order_relaxed);
+        }
+        for (size_t q = 0; q < queue_count; ++q) {
+            queues[q].heap.clear();
+            queues[q].top.store(INF, std::memory_order_relaxed);
+        }
+    }
+
+public:
+    explicit MultiQueueSSSP(const DynamicGraph& g, size_t objective_index = 0,
+                            int threads = omp_get_max_threads(), int queues_per_thread = 2)
+        : graph(g), objective(objective_index), num_threads(std::max(1, threads)),
+          queue_count(static_cast<size_t>(num_threads) * std::max(1, queues_per_thread)),
+          queues(new Queue[queue_count]) {}
+
+    void compute(int source) {
+        const int n = graph.node_count();
+        if (source < 0 || source >= n) throw std::out_of_range("Source ID out of range");
+
+        reset(n);
+        distances[source].store(0.0, std::memory_order_relaxed);
+        uint64_t seed_rng = 0x9E3779B97F4A7C15ULL;
+        pending.store(1, std::memory_order_relaxed);
+        push(seed_rng, 0.0, source);
+
+        #pragma omp parallel num_threads(num_threads)
+        {
+            uint64_t rng = 0x9E3779B97F4A7C15ULL * (omp_get_thread_num() + 1);
+            std::vector<std::pair<double, int>> children;
+            std::pair<double, int> item;
+
+            while (true) {
+                if (!try_pop(rng, item)) {
+                    if (pending.load(std::memory_order_acquire) == 0) break;
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                auto [dist_u, u] = item;
+                children.clear();
+                // A later entry carries the improvement that made this one stale
+                if (dist_u <= distances[u].load(std::memory_order_relaxed)) {
+                    for (const auto& edge : graph.get_edges(u)) {
+                        const int v = edge.target;
+                        const double new_dist = dist_u + edge.weights[objective];
+                        if (new_dist >= distances[v].load(std::memory_order_relaxed)) continue;
+
+                        while (!try_lock(node_locks[v])) {}
+                        if (new_dist < distances[v].load(std::memory_order_relaxed)) {
+                            distances[v].store(new_dist, std::memory_order_relaxed);
+                            predecessors[v] = u;
+                            children.emplace_back(new_dist, v);
+                        }
+                        unlock(node_locks[v]);
+                    }
+                }
+
+                // Hand this entry's count over to its children before they
+                // become visible to other threads
+                pending.fetch_add(static_cast<int64_t>(children.size()) - 1, std::memory_order_acq_rel);
+                for (const auto& [dist, v] : children) push(rng, dist, v);
+            }
+        }
+    }
+
+    double get_distance(int node) const {
+        if (node < 0 || static_cast<size_t>(node) >= predecessors.size()) {
+            throw std::out_of_range("Node ID out of range");
+        }
+        return distances[node].load(std::memory_order_relaxed);
+    }
+
+    const std::vector<int>& get_predecessors() const { return predecessors; }
+
+    // Node sequence source -> target (empty if unreachable)
+    std::vector<int> get_path(int target) const {
+        std::vector<int> path;
+        if (get_distance(target) == std::numeric_limits<double>::max()) return path;
+        for (int node = target; node != -1; node = predecessors[node]) {
+            path.push_back(node);
+        }
+        std::reverse(path.begin(), path.end());
+        return path;
+    }
+};
@@ -0,0 +1,32 @@
+#ifndef PARETO_MPI_HPP
+#define PARETO_MPI_HPP
+
+#include "path_result.hpp"
+#include <mpi.h>
+#include <vector>
+
+// Merging partial Pareto fronts across ranks with a user-defined MPI
+// reduction, so the merge is a log-depth tree instead of a gather to rank 0.
+//
+// A front travels as one flat buffer of doubles:
+//   [path_count, (objective_count, node_count, objectives..., nodes...)*]
+// Every rank reduces a buffer of the same capacity: the sum of all local
+// serialized sizes, which bounds any merged front.
+namespace Pareto {
+
+    std::vector<double> serialize_front(const std::vector<PathResult>& front);
+
+    // Reads one serialized front starting at buffer[0]
+    std::vector<PathResult> deserialize_front(const double* buffer);
+
+    // Collective: merged front of every rank's `local` front on `root`.
+    // Other ranks get an empty vector.
+    std::vector<PathResult> reduce_front(const std::vector<PathResult>& local,
+                                         int root = 0, MPI_Comm comm = MPI_COMM_WORLD);
+
+    // Collective: merged front on every rank
+    std::vector<PathResult> allreduce_front(const std::vector<PathResult>& local,
+                                            MPI_Comm comm = MPI_COMM_WORLD);
+}
+
+#endif // PARETO_MPI_HPP
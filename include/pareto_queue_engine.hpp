@@ -0,0 +1,213 @@
+#pragma once
+#include "graph.hpp"
+#include "pareto_utils.hpp"
+#include "path_result.hpp"
+#include "label_arena.hpp"
+#include <omp.h>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+// Parallel label-setting MOSP on a Pareto queue. Instead of popping one
+// lexicographic minimum, every round extracts all open labels that no other
+// open label dominates; with non-negative weights none of them can be
+// dominated later, so the whole set is expanded at once:
+//   1. expand the minimal set in parallel into thread-local candidates,
+//   2. group candidates by head node and merge each group into that node's
+//      label set in parallel (one thread owns a node for the round),
+//   3. append the survivors to the arena and the open set.
+// Returns the same front as MOSPEngine::compute_pareto, in lexicographic order.
+class ParetoQueueEngine {
+    DynamicGraph& graph;
+    std::vector<size_t> weight_indices;
+    int num_threads;
+
+    struct Candidate {
+        double objs[MAX_LABEL_OBJECTIVES];
+        int node;
+        int parent;
+    };
+
+    LabelArena arena;
+    std::vector<std::vector<int>> node_labels;  // live labels per node
+    std::vector<int> labeled_nodes;
+    size_t rounds = 0;
+
+public:
+    explicit ParetoQueueEngine(DynamicGraph& g, const std::vector<size_t>& indices = {0},
+                               int threads = omp_get_max_threads())
+        : graph(g), weight_indices(indices), num_threads(std::max(1, threads)) {
+        if (indices.size() > MAX_LABEL_OBJECTIVES) {
+            throw std::invalid_argument("Too many objectives for label-setting");
+        }
+    }
+
+    std::vector<PathResult> compute_pareto(int source, int target) {
+        const int n = graph.node_count();
+        const size_t K = weight_indices.size();
+        if (source < 0 || source >= n || target < 0 || target >= n) return {};
+
+        reset_labels(n);
+        rounds = 0;
+
+        int root = arena.allocate();
+        arena[root].node = source;
+        arena[root].parent = -1;
+        arena[root].dead = false;
+        std::fill_n(arena[root].objs, K, 0.0);
+        add_live_label(source, root);
+
+        std::vector<int> open{root}, minimal, results;
+        std::vector<std::vector<Candidate>> thread_candidates(num_threads);
+        std::vector<Candidate> candidates;
+        std::vector<size_t> group_start;
+        std::vector<char> accepted;
+
+        while (!open.empty()) {
+            ++rounds;
+
+            // Extract the minimal set; dominated labels stay open
+            std::vector<char> keep = Pareto::detail::nondominated_mask(open.size(), K,
+                [&](size_t i) { return static_cast<const double*>(arena[open[i]].objs); });
+            minimal.clear();
+            size_t rest = 0;
+            for (size_t i = 0; i < open.size(); ++i) {
+                if (keep[i]) minimal.push_back(open[i]);
+                else open[rest++] = open[i];
+            }
+            open.resize(rest);
+
+            for (int id : minimal) {
+                if (arena[id].node == target) results.push_back(id);
+            }
+
+            // 1. Parallel expansion; node label sets are read-only here
+            #pragma omp parallel for schedule(dynamic, 16) num_threads(num_threads)
+            for (size_t m = 0; m < minimal.size(); ++m) {
+                const Label& label = arena[minimal[m]];
+                if (label.node == target || covered_by(results, label.objs, K)) continue;
+
+                auto& local = thread_candidates[omp_get_thread_num()];
+                for (const auto& edge : graph.get_edges(label.node)) {
+                    Candidate cand;
+                    for (size_t i = 0; i < K; ++i) {
+                        cand.objs[i] = label.objs[i] + edge.weights[weight_indices[i]];
+                    }
+                    if (covered_by(node_labels[edge.target], cand.objs, K) ||
+                        covered_by(results, cand.objs, K)) {
+                        continue;
+                    }
+                    cand.node = edge.target;
+                    cand.parent = minimal[m];
+                    local.push_back(cand);
+                }
+            }
+
+            candidates.clear();
+            for (auto& local : thread_candidates) {
+                candidates.insert(candidates.end(), local.begin(), local.end());
+                local.clear();
+            }
+            if (candidates.empty() && open.empty()) break;
+
+            // 2. Group by head node, lexicographic within a group, so an
+            //    accepted candidate is never dominated by a later one
+            std::sort(candidates.begin(), candidates.end(), [K](const Candidate& a, const Candidate& b) {
+                if (a.node != b.node) return a.node < b.node;
+                return std::lexicographical_compare(a.objs, a.objs + K, b.objs, b.objs + K);
+            });
+            group_start.clear();
+            for (size_t c = 0; c < candidates.size(); ++c) {
+                if (c == 0 || candidates[c].node != candidates[c - 1].node) group_start.push_back(c);
+            }
+            group_start.push_back(candidates.size());
+            accepted.assign(candidates.size(), 0);
+            const size_t groups = group_start.size() - 1;
+
+            #pragma omp parallel for schedule(dynamic, 8) num_threads(num_threads)
+            for (size_t g = 0; g < groups; ++g) {
+                const int node = candidates[group_start[g]].node;
+                auto& live = node_labels[node];  // accepted candidates join in step 3
+
+                for (size_t c = group_start[g]; c < group_start[g + 1]; ++c) {
+                    const double* objs = candidates[c].objs;
+                    bool rejected = false;
+                    for (int other : live) {
+                        if (covers(arena[other].objs, objs, K)) { rejected = true; break; }
+                    }
+                    for (size_t a = group_start[g]; a < c && !rejected; ++a) {
+                        rejected = accepted[a] && covers(candidates[a].objs, objs, K);
+                    }
+                    if (rejected) continue;
+
+                    // Existing labels the candidate dominates are dropped
+                    live.erase(std::remove_if(live.begin(), live.end(), [&](int other) {
+                        Label& existing = arena[other];
+                        if (!Pareto::dominates(objs, existing.objs, K)) return false;
+                        existing.dead = true;
+                        return true;
+                    }), live.end());
+                    accepted[c] = 1;
+                }
+            }
+
+            // 3. Survivors become labels; dropped labels leave the open set
+            for (size_t c = 0; c < candidates.size(); ++c) {
+                if (!accepted[c]) continue;
+                int id = arena.allocate();
+                Label& label = arena[id];
+                std::copy_n(candidates[c].objs, K, label.objs);
+                label.node = candidates[c].node;
+                label.parent = candidates[c].parent;
+                label.dead = false;
+                add_live_label(label.node, id);
+                open.push_back(id);
+            }
+            open.erase(std::remove_if(open.begin(), open.end(),
+                [&](int id) { return arena[id].dead; }), open.end());
+        }
+
+        std::sort(results.begin(), results.end(), [&](int a, int b) {
+            return std::lexicographical_compare(arena[a].objs, arena[a].objs + K,
+                                                arena[b].objs, arena[b].objs + K);
+        });
+
+        std::vector<PathResult> front(results.size());
+        for (size_t r = 0; r < results.size(); ++r) {
+            int id = results[r];
+            front[r].objectives.assign(arena[id].objs, arena[id].objs + K);
+            for (int l = id; l != -1; l = arena[l].parent) front[r].nodes.push_back(arena[l].node);
+            std::reverse(front[r].nodes.begin(), front[r].nodes.end());
+        }
+        return front;
+    }
+
+    // Pareto-queue rounds of the last compute_pareto call
+    size_t get_round_count() const { return rounds; }
+    size_t get_label_count() const { return arena.size(); }
+
+private:
+    // a is at least as good as b in every objective
+    static bool covers(const double* a, const double* b, size_t k) {
+        return std::equal(a, a + k, b) || Pareto::dominates(a, b, k);
+    }
+
+    bool covered_by(const std::vector<int>& ids, const double* objs, size_t k) const {
+        for (int id : ids) {
+            if (covers(arena[id].objs, objs, k)) return true;
+        }
+        return false;
+    }
+
+    void add_live_label(int node, int id) {
+        if (node_labels[node].empty()) labeled_nodes.push_back(node);
+        node_labels[node].push_back(id);
+    }
+
+    void reset_labels(int n) {
+        arena.reset();
+        if (static_cast<int>(node_labels.size()) < n) node_labels.resize(n);
+        for (int node : labeled_nodes) node_labels[node].clear();
+        labeled_nodes.clear();
+    }
+};
@@ -1,17 +1,168 @@
 #pragma once
 #include <vector>
+#include <map>
+#include <array>
+#include <numeric>
+#include <algorithm>
+#include <limits>
+#include <iterator>
 #include "path_result.hpp"  // Include the new header
+#include "dominance_kernel.hpp"
 
 namespace Pareto {
     // Check if path A dominates path B
-    inline bool dominates(const std::vector<double>& a, 
+    inline bool dominates(const std::vector<double>& a,
                          const std::vector<double>& b) {
-        bool at_least_one_better = false;
-        for (size_t i = 0; i < a.size(); ++i) {
-            if (a[i] > b[i]) return false;
-            if (a[i] < b[i]) at_least_one_better = true;
+        return simd::dominates(a.data(), b.data(), a.size());
+    }
+
+    inline bool dominates(const double* a, const double* b, size_t k) {
+        return simd::dominates(a, b, k);
+    }
+
+    namespace detail {
+        // keep[i] = 1 if entry i is not dominated by any other entry.
+        // objs(i) returns a pointer to the k objectives of entry i. Equal
+        // vectors do not dominate each other, so duplicates are all kept.
+        //   k == 2: lexicographic sort + linear scan, O(n log n)
+        //   k == 3: lexicographic sweep over a balanced-tree staircase, O(n log n)
+        //   k >= 4: Sort-Filter-Skyline against the front found so far
+        template <typename Objs>
+        std::vector<char> nondominated_mask(size_t n, size_t k, Objs objs) {
+            std::vector<char> keep(n, 0);
+            if (n == 0) return keep;
+
+            std::vector<size_t> order(n);
+            std::iota(order.begin(), order.end(), 0);
+
+            if (k <= 1) {
+                double best = std::numeric_limits<double>::infinity();
+                for (size_t i = 0; i < n; ++i) best = std::min(best, k ? objs(i)[0] : 0.0);
+                for (size_t i = 0; i < n; ++i) keep[i] = !k || objs(i)[0] == best;
+                return keep;
+            }
+
+            if (k <= 3) {
+                // In lexicographic order only earlier entries can dominate later
+                // ones. Sort keys by value so comparisons stay in cache.
+                std::vector<std::pair<std::array<double, 3>, size_t>> keys(n);
+                for (size_t i = 0; i < n; ++i) {
+                    const double* p = objs(i);
+                    keys[i] = {{p[0], p[1], k == 3 ? p[2] : 0.0}, i};
+                }
+                std::sort(keys.begin(), keys.end());
+                for (size_t i = 0; i < n; ++i) order[i] = keys[i].second;
+            } else {
+                // A dominator never has a larger sum, but rounding can make the
+                // sums equal, e.g. (1e20, 1, ..) and (1e20, 2, ..). Ties fall back
+                // to lexicographic order, where a dominator always comes first.
+                std::vector<double> sums(n);
+                for (size_t i = 0; i < n; ++i) sums[i] = std::accumulate(objs(i), objs(i) + k, 0.0);
+                std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+                    if (sums[a] != sums[b]) return sums[a] < sums[b];
+                    return std::lexicographical_compare(objs(a), objs(a) + k, objs(b), objs(b) + k);
+                });
+            }
+
+            if (k == 2) {
+                // Lowest second objective seen so far, and the first objective
+                // of the (lexicographically first) entry that reached it
+                double best2 = std::numeric_limits<double>::infinity();
+                double best1 = std::numeric_limits<double>::infinity();
+                for (size_t i : order) {
+                    const double* p = objs(i);
+                    if (best2 < p[1] || (best2 == p[1] && best1 < p[0])) continue;
+                    keep[i] = 1;
+                    if (p[1] < best2) {
+                        best2 = p[1];
+                        best1 = p[0];
+                    }
+                }
+                return keep;
+            }
+
+            if (k == 3) {
+                // Staircase of kept entries projected on (o2, o3): keys o2
+                // ascending, o3 strictly descending; o1 of the first entry kept
+                struct Step { double o3; double o1; };
+                std::map<double, Step> stairs;
+
+                for (size_t i : order) {
+                    const double* p = objs(i);
+
+                    auto it = stairs.upper_bound(p[1]);
+                    if (it != stairs.begin()) {
+                        auto below = std::prev(it);
+                        double o3 = below->second.o3;
+                        bool same_point = below->first == p[1] && o3 == p[2];
+                        if (o3 < p[2] || (o3 == p[2] && !same_point)) continue;
+                        if (same_point && below->second.o1 < p[0]) continue;
+                        if (same_point) {
+                            keep[i] = 1;  // exact duplicate of a kept entry
+                            continue;
+                        }
+                    }
+
+                    keep[i] = 1;
+                    // Drop steps the new entry covers, then insert it
+                    auto first = stairs.lower_bound(p[1]);
+                    auto last = first;
+                    while (last != stairs.end() && last->second.o3 >= p[2]) ++last;
+                    stairs.erase(first, last);
+                    stairs.emplace(p[1], Step{p[2], p[0]});
+                }
+                return keep;
+            }
+
+            // Kept front stored contiguously for a cache-friendly scan
+            std::vector<double> front;
+            for (size_t i : order) {
+                const double* p = objs(i);
+                if (simd::dominated_by_any(front.data(), front.size() / k, p, k)) continue;
+                keep[i] = 1;
+                front.insert(front.end(), p, p + k);
+            }
+            return keep;
+        }
+
+        // Stable in-place compaction: survivors keep their relative order
+        template <typename T, typename Objs>
+        void compact_nondominated(std::vector<T>& items, Objs objective_vector) {
+            if (items.empty()) return;
+
+            size_t k = objective_vector(items[0]).size();
+            bool uniform = std::all_of(items.begin(), items.end(),
+                [&](const T& item) { return objective_vector(item).size() == k; });
+
+            std::vector<char> keep;
+            if (uniform) {
+                // Flat copy keeps the sort and scans on contiguous memory
+                std::vector<double> flat(items.size() * k);
+                for (size_t i = 0; i < items.size(); ++i) {
+                    std::copy_n(objective_vector(items[i]).data(), k, &flat[i * k]);
+                }
+                keep = nondominated_mask(items.size(), k,
+                    [&](size_t i) { return &flat[i * k]; });
+            } else {
+                // Mixed lengths: plain pairwise check, still without erase
+                keep.assign(items.size(), 1);
+                for (size_t i = 0; i < items.size(); ++i) {
+                    for (size_t j = 0; j < items.size() && keep[i]; ++j) {
+                        if (i != j && dominates(objective_vector(items[j]), objective_vector(items[i]))) {
+                            keep[i] = 0;
+                        }
+                    }
+                }
+            }
+
+            size_t out = 0;
+            for (size_t i = 0; i < items.size(); ++i) {
+                if (!keep[i]) continue;
+                if (out != i) items[out] = std::move(items[i]);
+                ++out;
+            }
+            items.resize(out);
         }
-        return at_least_one_better;
     }
 
     // Primary template
@@ -22,17 +173,8 @@ namespace Pareto {
     template <>
     struct DominanceFilter<std::vector<double>> {
         static void filter(std::vector<std::vector<double>>& paths) {
-            auto it = paths.begin();
-            while (it != paths.end()) {
-                bool dominated = false;
-                for (const auto& other : paths) {
-                    if (&(*it) != &other && dominates(other, *it)) {
-                        dominated = true;
-                        break;
-                    }
-                }
-                it = dominated ? paths.erase(it) : ++it;
-            }
+            detail::compact_nondominated(paths,
+                [](const std::vector<double>& p) -> const std::vector<double>& { return p; });
         }
     };
 
@@ -40,17 +182,8 @@ namespace Pareto {
     template <>
     struct DominanceFilter<PathResult> {
         static void filter(std::vector<PathResult>& paths) {
-            auto it = paths.begin();
-            while (it != paths.end()) {
-                bool dominated = false;
-                for (const auto& other : paths) {
-                    if (&(*it) != &other && dominates(other.objectives, it->objectives)) {
-                        dominated = true;
-                        break;
-                    }
-                }
-                it = dominated ? paths.erase(it) : ++it;
-            }
+            detail::compact_nondominated(paths,
+                [](const PathResult& p) -> const std::vector<double>& { return p.objectives; });
         }
     };
 
@@ -59,4 +192,30 @@ namespace Pareto {
     void filter_dominated(std::vector<T>& paths) {
         DominanceFilter<T>::filter(paths);
     }
-}
\ No newline at end of file
+
+    // Merge partial fronts (one per thread, rank, ...) into one Pareto front.
+    // Pairs are merged in a balanced tree, log2(n) levels whose merges run
+    // in parallel. Survivors keep the order of the input fronts.
+    template <typename T>
+    std::vector<T> merge_fronts(std::vector<std::vector<T>> fronts) {
+        if (fronts.empty()) return {};
+        const size_t n = fronts.size();
+
+        for (size_t stride = 1; stride < n; stride *= 2) {
+            const long pairs = static_cast<long>((n - stride + 2 * stride - 1) / (2 * stride));
+            #pragma omp parallel for schedule(dynamic, 1)
+            for (long p = 0; p < pairs; ++p) {
+                size_t left = static_cast<size_t>(p) * 2 * stride;
+                auto& merged = fronts[left];
+                auto& right = fronts[left + stride];
+                merged.insert(merged.end(), std::make_move_iterator(right.begin()),
+                              std::make_move_iterator(right.end()));
+                std::vector<T>().swap(right);
+                filter_dominated(merged);
+            }
+        }
+        // A single input front may still hold dominated entries
+        if (n == 1) filter_dominated(fronts[0]);
+        return std::move(fronts[0]);
+    }
+}
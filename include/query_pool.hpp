@@ -0,0 +1,261 @@
+#pragma once
+#include "graph.hpp"
+#include "path_result.hpp"
+#include "radix_heap.hpp"
+#include "indexed_heap.hpp"
+#include <omp.h>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include <cstdint>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+// Nodes and edges hidden from a query without copying the graph. Blocking
+// u->v hides every parallel u->v edge.
+struct GraphMask {
+    std::vector<char> blocked_nodes;      // indexed by node; may be shorter than the graph
+    std::vector<int> blocked_list;        // nodes set in blocked_nodes
+    std::vector<uint64_t> blocked_edges;  // sorted edge_key(u, v)
+
+    static uint64_t edge_key(int u, int v) {
+        return (static_cast<uint64_t>(u) << 32) | static_cast<uint32_t>(v);
+    }
+
+    void block_node(int node) {
+        if (node >= static_cast<int>(blocked_nodes.size())) blocked_nodes.resize(node + 1, 0);
+        if (!blocked_nodes[node]) blocked_list.push_back(node);
+        blocked_nodes[node] = 1;
+    }
+
+    void block_edge(int u, int v) {
+        uint64_t key = edge_key(u, v);
+        auto it = std::lower_bound(blocked_edges.begin(), blocked_edges.end(), key);
+        if (it == blocked_edges.end() || *it != key) blocked_edges.insert(it, key);
+    }
+
+    bool node_blocked(int node) const {
+        return node < static_cast<int>(blocked_nodes.size()) && blocked_nodes[node];
+    }
+
+    bool edge_blocked(int u, int v) const {
+        return !blocked_edges.empty() &&
+               std::binary_search(blocked_edges.begin(), blocked_edges.end(), edge_key(u, v));
+    }
+
+    // Unblock everything, keeping capacity
+    void clear() {
+        for (int node : blocked_list) blocked_nodes[node] = 0;
+        blocked_list.clear();
+        blocked_edges.clear();
+    }
+};
+
+// Reusable state for one sequential Dijkstra query on a shared read-only graph.
+// Only the entries touched by the previous query are reset, so one context
+// can serve many small queries without re-initializing N-sized arrays.
+// Objectives with integer or declared-quantized weights (see
+// DynamicGraph::get_weight_quantum) run on a radix heap with integer
+// distances instead of the indexed 4-ary heap of doubles.
+class QueryContext {
+    std::vector<double> distances;
+    std::vector<int> predecessors;
+    std::vector<int> touched;
+    IndexedDaryHeap<4> heap;
+    std::vector<uint64_t> int_distances;  // in quanta; integer queries only
+    RadixHeap<int> radix;
+
+    void reset(size_t node_count) {
+        const double INF = std::numeric_limits<double>::max();
+        for (int node : touched) {
+            distances[node] = INF;
+            predecessors[node] = -1;
+        }
+        if (!int_distances.empty()) {
+            for (int node : touched) int_distances[node] = UINT64_MAX;
+        }
+        touched.clear();
+        heap.clear();
+        radix.clear();
+
+        // The graph may have grown since the last query
+        if (distances.size() < node_count) {
+            distances.resize(node_count, INF);
+            predecessors.resize(node_count, -1);
+        }
+    }
+
+    void relax(int node, double dist, int pred) {
+        if (distances[node] == std::numeric_limits<double>::max()) {
+            touched.push_back(node);
+        }
+        distances[node] = dist;
+        predecessors[node] = pred;
+        heap.push(node, dist);
+    }
+
+public:
+    // Dijkstra on edge.weights[objective]. Stops as soon as `target` is settled;
+    // a negative target computes the full shortest-path tree. Nodes and edges
+    // blocked by `mask` are skipped.
+    // Returns the distance to target (infinity if unreachable or target < 0).
+    // Throws std::out_of_range for a source or target outside the graph.
+    double run(const DynamicGraph& graph, int source, int target = -1, size_t objective = 0,
+               const GraphMask* mask = nullptr) {
+        const double INF = std::numeric_limits<double>::max();
+        if (source < 0 || source >= static_cast<int>(graph.node_count())) {
+            throw std::out_of_range("Source ID out of range");
+        }
+        if (target >= static_cast<int>(graph.node_count())) {
+            throw std::out_of_range("Target ID out of range");
+        }
+
+        reset(graph.node_count());
+        const double quantum = graph.get_weight_quantum(objective);
+        if (quantum > 0) return run_integer(graph, source, target, objective, mask, quantum);
+        relax(source, 0.0, -1);
+
+        while (!heap.empty()) {
+            auto [dist_u, u] = heap.pop();
+            if (u == target) return dist_u;
+
+            for (const auto& edge : graph.get_edges(u)) {
+                double new_dist = dist_u + edge.weights[objective];
+                if (new_dist < distances[edge.target]) {
+                    if (mask && (mask->node_blocked(edge.target) || mask->edge_blocked(u, edge.target))) {
+                        continue;
+                    }
+                    relax(edge.target, new_dist, u);
+                }
+            }
+        }
+
+        return target >= 0 ? distances[target] : INF;
+    }
+
+private:
+    // Same search on integer distances counted in quanta; the radix heap
+    // relies on popped keys never decreasing
+    double run_integer(const DynamicGraph& graph, int source, int target, size_t objective,
+                       const GraphMask* mask, double quantum) {
+        const double INF = std::numeric_limits<double>::max();
+        if (int_distances.size() < distances.size()) int_distances.resize(distances.size(), UINT64_MAX);
+        const bool unit = quantum == 1.0;
+
+        auto relax_int = [&](int node, uint64_t dist, int pred) {
+            if (int_distances[node] == UINT64_MAX) touched.push_back(node);
+            int_distances[node] = dist;
+            distances[node] = unit ? static_cast<double>(dist) : static_cast<double>(dist) * quantum;
+            predecessors[node] = pred;
+            radix.push(dist, node);
+        };
+
+        relax_int(source, 0, -1);
+        while (!radix.empty()) {
+            auto [dist_u, u] = radix.pop();
+            if (dist_u > int_distances[u]) continue;
+            if (u == target) return distances[u];
+
+            for (const auto& edge : graph.get_edges(u)) {
+                const double w = edge.weights[objective];
+                uint64_t new_dist = dist_u + static_cast<uint64_t>(unit ? w : std::llround(w / quantum));
+                if (new_dist < int_distances[edge.target]) {
+                    if (mask && (mask->node_blocked(edge.target) || mask->edge_blocked(u, edge.target))) {
+                        continue;
+                    }
+                    relax_int(edge.target, new_dist, u);
+                }
+            }
+        }
+
+        return target >= 0 ? distances[target] : INF;
+    }
+
+public:
+    double get_distance(int node) const {
+        if (node < 0) throw std::out_of_range("Node ID out of range");
+        if (node >= static_cast<int>(distances.size())) return std::numeric_limits<double>::max();
+        return distances[node];
+    }
+
+    int get_predecessor(int node) const {
+        if (node < 0) throw std::out_of_range("Node ID out of range");
+        if (node >= static_cast<int>(predecessors.size())) return -1;
+        return predecessors[node];
+    }
+
+    // Node sequence source -> target from the last run (empty if unreachable)
+    std::vector<int> get_path(int target) const {
+        std::vector<int> path;
+        if (get_distance(target) == std::numeric_limits<double>::max()) return path;
+        for (int node = target; node != -1; node = predecessors[node]) {
+            path.push_back(node);
+        }
+        std::reverse(path.begin(), path.end());
+        return path;
+    }
+};
+
+// Thread-level parallelism across many independent queries: one immutable
+// graph, one reusable QueryContext per OpenMP thread.
+class QueryPool {
+    const DynamicGraph& graph;
+    std::vector<QueryContext> contexts;
+
+public:
+    struct Query {
+        int source;
+        int target;
+    };
+
+private:
+    // An exception escaping the parallel loop would terminate the process,
+    // so every query is checked up front. Paths need a real target.
+    void validate(const std::vector<Query>& queries, bool need_target) const {
+        const int n = static_cast<int>(graph.node_count());
+        for (size_t i = 0; i < queries.size(); ++i) {
+            if (queries[i].source < 0 || queries[i].source >= n) {
+                throw std::out_of_range("Query " + std::to_string(i) + ": source ID out of range");
+            }
+            if (queries[i].target >= n || (need_target && queries[i].target < 0)) {
+                throw std::out_of_range("Query " + std::to_string(i) + ": target ID out of range");
+            }
+        }
+    }
+
+public:
+    explicit QueryPool(const DynamicGraph& g, int num_threads = omp_get_max_threads())
+        : graph(g), contexts(std::max(1, num_threads)) {}
+
+    // Shortest distance for each query, in input order
+    std::vector<double> distances(const std::vector<Query>& queries, size_t objective = 0) {
+        validate(queries, false);
+        std::vector<double> results(queries.size());
+
+        #pragma omp parallel for schedule(dynamic, 16) num_threads(contexts.size())
+        for (size_t i = 0; i < queries.size(); ++i) {
+            QueryContext& ctx = contexts[omp_get_thread_num()];
+            results[i] = ctx.run(graph, queries[i].source, queries[i].target, objective);
+        }
+        return results;
+    }
+
+    // Shortest path for each query; unreachable targets yield an empty path
+    std::vector<PathResult> paths(const std::vector<Query>& queries, size_t objective = 0) {
+        validate(queries, true);
+        std::vector<PathResult> results(queries.size());
+
+        #pragma omp parallel for schedule(dynamic, 16) num_threads(contexts.size())
+        for (size_t i = 0; i < queries.size(); ++i) {
+            QueryContext& ctx = contexts[omp_get_thread_num()];
+            double dist = ctx.run(graph, queries[i].source, queries[i].target, objective);
+            results[i] = {ctx.get_path(queries[i].target), {dist}};
+        }
+        return results;
+    }
+
+    size_t size() const { return contexts.size(); }
+    QueryContext& get_context(int thread) { return contexts.at(thread); }
+};
@@ -0,0 +1,34 @@
+#ifndef QUERY_SCHEDULER_HPP
+#define QUERY_SCHEDULER_HPP
+
+#include <mpi.h>
+#include <vector>
+#include <functional>
+#include <cstdint>
+
+// Distributed self-scheduling of a batch of queries (e.g. SSSP sources).
+// Every rank starts on a contiguous home block of the batch and claims work
+// from it in chunks through an MPI RMA counter. Once its block is exhausted
+// it steals chunks from the other ranks' counters, so no rank idles while
+// work remains anywhere.
+class WorkStealingScheduler {
+public:
+    explicit WorkStealingScheduler(MPI_Comm comm = MPI_COMM_WORLD, int chunk_size = 1);
+
+    // Collective. `tasks` must be identical on every rank; process(task) is
+    // called exactly once per task on whichever rank claims it.
+    // Returns the number of tasks this rank executed.
+    size_t run(const std::vector<int>& tasks, const std::function<void(int)>& process);
+
+    // Tasks this rank took from other ranks' blocks during the last run
+    size_t get_stolen_count() const { return stolen; }
+
+private:
+    MPI_Comm comm;
+    int chunk_size;
+    size_t stolen;
+
+    static int64_t block_begin(int64_t n, int nranks, int r);
+};
+
+#endif // QUERY_SCHEDULER_HPP
@@ -0,0 +1,77 @@
+#ifndef QUERY_SERVER_HPP
+#define QUERY_SERVER_HPP
+
+#include "graph.hpp"
+#include "query_pool.hpp"
+#include "sssp_cache.hpp"
+#include <iostream>
+#include <string>
+#include <mutex>
+
+// Long-running query service: the graph is loaded and partitioned once and
+// then serves any number of requests, so each request only pays query time.
+//
+// Full shortest path trees are kept in an LRU cache keyed by source and
+// objective, so repeated depot queries are a lookup. UPDATE/DELETE repair or
+// evict only the cached trees the changed edge can affect.
+//
+// Line protocol (one request per line, one response per request):
+//   QUERY s t [obj]      -> OK <dist> <node> <node> ...   (OK INF if unreachable;
+//                           the tree of s is cached)
+//   SSSP s [obj]         -> OK <d0> <d1> ... <dN-1>       (INF for unreachable;
+//                           the tree is cached)
+//   BATCH k [obj]        -> followed by k "s t" lines, answered with k
+//                           "OK <dist>" lines computed in parallel
+//                           (k <= MAX_BATCH_QUERIES; if the stream ends
+//                           early, only the lines received are answered)
+//   UPDATE u v w1 [w2..] -> OK   (insert edge or overwrite its weights;
+//                           u and v must be existing nodes)
+//   DELETE u v           -> OK
+//   STATS                -> OK <nodes> <edges> <partitions> <cached trees>
+//                           <cache hits> <cache misses>
+//   QUIT                 -> BYE  (ends the session)
+//   SHUTDOWN             -> BYE  (ends the session and stops the server)
+// Malformed requests are answered with "ERR <reason>".
+class QueryServer {
+public:
+    QueryServer(DynamicGraph graph, int num_partitions = 1,
+                int num_threads = omp_get_max_threads(),
+                size_t cache_bytes = 64 << 20);
+
+    QueryServer(const QueryServer&) = delete;
+    QueryServer& operator=(const QueryServer&) = delete;
+
+    // Serve requests from `in` until QUIT, SHUTDOWN or end of stream.
+    // Returns false once a client asked the server to shut down. Safe to run
+    // for several streams at once; requests are applied one at a time.
+    bool serve(std::istream& in, std::ostream& out);
+
+    // Accept connections on a Unix domain socket, each served by its own
+    // thread, until a client sends SHUTDOWN; that ends every open session.
+    // An existing socket at `path` is replaced, any other file is refused.
+    void serve_unix_socket(const std::string& path);
+
+    const DynamicGraph& get_graph() const { return graph; }
+
+    // Largest BATCH a client may announce
+    static constexpr long MAX_BATCH_QUERIES = 1 << 20;
+
+private:
+    std::mutex state_mutex;  // held while a request reads or changes the state below
+    DynamicGraph graph;
+    QueryPool pool;
+    SSSPCache cache;
+    int num_partitions;
+    size_t num_objectives;  // weights available on every edge
+
+    void handle_query(std::istream& args, std::ostream& out);
+    void handle_sssp(std::istream& args, std::ostream& out);
+    void handle_batch(std::istream& args, std::istream& in, std::ostream& out);
+    void handle_update(std::istream& args, std::ostream& out);
+    void handle_delete(std::istream& args, std::ostream& out);
+
+    void check_node(int node) const;
+    void check_objective(size_t objective) const;
+};
+
+#endif // QUERY_SERVER_HPP
@@ -0,0 +1,63 @@
+#pragma once
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+// Monotone radix heap over uint64_t keys (Ahuja et al.). Keys pushed must not
+// be below the last popped key, which holds for Dijkstra with non-negative
+// integer weights. Bucket i holds keys whose highest bit differing from the
+// last popped key is bit i-1; a pop only redistributes the first non-empty
+// bucket, so each entry moves at most 64 times and no comparisons are made
+// between entries of different buckets.
+template <typename Value>
+class RadixHeap {
+    static constexpr int BUCKETS = 65;
+
+    std::vector<std::pair<uint64_t, Value>> buckets[BUCKETS];
+    uint64_t last = 0;
+    size_t count = 0;
+
+    static int bucket_of(uint64_t key, uint64_t last) {
+        return key == last ? 0 : 64 - __builtin_clzll(key ^ last);
+    }
+
+public:
+    void push(uint64_t key, const Value& value) {
+        buckets[bucket_of(key, last)].emplace_back(key, value);
+        ++count;
+    }
+
+    // Entry with the smallest key; the heap must not be empty
+    std::pair<uint64_t, Value> pop() {
+        if (buckets[0].empty()) {
+            int b = 1;
+            while (buckets[b].empty()) ++b;
+
+            uint64_t min_key = buckets[b][0].first;
+            for (const auto& entry : buckets[b]) {
+                if (entry.first < min_key) min_key = entry.first;
+            }
+            last = min_key;
+            for (const auto& entry : buckets[b]) {
+                buckets[bucket_of(entry.first, last)].push_back(entry);
+            }
+            buckets[b].clear();
+        }
+
+        std::pair<uint64_t, Value> top = buckets[0].back();
+        buckets[0].pop_back();
+        --count;
+        return top;
+    }
+
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+
+    // Empty the heap and restart from key 0, keeping bucket capacity
+    void clear() {
+        for (auto& bucket : buckets) bucket.clear();
+        last = 0;
+        count = 0;
+    }
+};
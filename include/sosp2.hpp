@@ -1,7 +1,7 @@
 #pragma once
 #include "graph.hpp"
+#include "indexed_heap.hpp"
 #include <vector>
-#include <queue>
 #include <limits>
 #include <iostream>
 
@@ -16,29 +16,23 @@ public:
         std::vector<double> distances(graph.node_count(), INF);
         distances[source] = 0.0;
 
-        // Min-heap: pairs of (distance, node)
-        std::priority_queue<std::pair<double, int>,
-                          std::vector<std::pair<double, int>>,
-                          std::greater<>> pq;
-        pq.push({0.0, source});
+        // Indexed min-heap of (distance, node): one entry per node, keys
+        // lowered in place, so no stale entries to skip
+        IndexedDaryHeap<4> pq;
+        pq.reserve_nodes(graph.node_count());
+        pq.push(source, 0.0);
 
         while (!pq.empty()) {
-            auto [current_dist, u] = pq.top();
-            pq.pop();
-
-            // Crucial optimization: Skip if we already found a better path
-            if (current_dist > distances[u]) {
-                continue;
-            }
+            auto [current_dist, u] = pq.pop();
 
             // Explore all neighbors
             for (const auto& edge : graph.get_edges(u)) {
                 double new_dist = current_dist + edge.weights[0];
                 
-                // Only update and push to queue if we found a better path
+                // Only update and queue (or decrease) if we found a better path
                 if (new_dist < distances[edge.target]) {
                     distances[edge.target] = new_dist;
-                    pq.push({new_dist, edge.target});
+                    pq.push(edge.target, new_dist);
                     
                     // Debug output to verify relaxation
                     std::cout << "Relaxed " << u << "->" << edge.target 
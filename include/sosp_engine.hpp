@@ -1,135 +1,232 @@
 #pragma once
 #include "graph.hpp"
+#include "indexed_heap.hpp"
 #include <omp.h>
 #include <vector>
 #include <queue>
 #include <limits>
 #include <atomic>
 #include <mutex>
+#include <thread>
+#include <algorithm>
 
-class SOSPEngine {
+// Selects the objective an engine relaxes on: edge.weights[index]
+struct ObjectiveWeight {
+    size_t index = 0;
+
+    double operator()(const DynamicGraph::Edge& edge) const {
+        return edge.weights[index];
+    }
+};
+
+// Queue is the priority queue policy (see indexed_heap.hpp). The default
+// indexed 4-ary heap queues each node once and lowers its key in place; the
+// lazy binary heap queues one entry per relaxation.
+template <typename WeightFn = ObjectiveWeight, typename Queue = IndexedDaryHeap<4>>
+class BasicSOSPEngine {
     DynamicGraph& graph;
+    WeightFn weight;
     std::vector<double> distances;
     std::vector<int> predecessors;
-    std::vector<std::atomic<bool>> in_queue;
+    Queue queue;
 
 public:
-    explicit SOSPEngine(DynamicGraph& g) : graph(g), in_queue(g.node_count()) {}
+    explicit BasicSOSPEngine(DynamicGraph& g, WeightFn w = WeightFn())
+        : graph(g), weight(w) {}
 
     void compute(int source) {
         const double INF = std::numeric_limits<double>::max();
         distances.assign(graph.node_count(), INF);
         predecessors.assign(graph.node_count(), -1);
 
-        for (auto& flag : in_queue) {
-            flag.store(false);
-        }
-
         distances[source] = 0.0;
 
         // Shared priority queue protected by a mutex
-        std::priority_queue<std::pair<double, int>, 
-                            std::vector<std::pair<double, int>>, 
-                            std::greater<>> global_queue;
+        queue.clear();
+        queue.reserve_nodes(graph.node_count());
         std::mutex queue_mutex;
 
-        global_queue.emplace(0.0, source);
-        in_queue[source].store(true);
+        queue.push(source, 0.0);
 
-        int active_threads = omp_get_max_threads(); // ← Plain int now
-        bool global_active = true;
+        // Threads between a pop and the end of its relaxations. Checked under
+        // the queue lock: an empty queue with nobody expanding means done.
+        std::atomic<int> expanding{0};
 
         #pragma omp parallel
         {
-            while (global_active) {
+            while (true) {
                 std::pair<double, int> current;
-                bool has_work = false;
+                bool has_work = false, done = false;
 
                 // Try to get work from the queue
                 {
                     std::lock_guard<std::mutex> lock(queue_mutex);
-                    if (!global_queue.empty()) {
-                        current = global_queue.top();
-                        global_queue.pop();
+                    if (!queue.empty()) {
+                        current = queue.pop();
                         has_work = true;
+                        expanding.fetch_add(1, std::memory_order_relaxed);
+                    } else {
+                        done = expanding.load(std::memory_order_acquire) == 0;
                     }
                 }
 
+                if (done) break;
                 if (!has_work) {
-                    #pragma omp atomic
-                    --active_threads;
-
-                    #pragma omp barrier
-
-                    #pragma omp single
-                    {
-                        if (active_threads == 0) {
-                            global_active = false;
-                        }
-                    }
-
-                    #pragma omp barrier
-
-                    if (!global_active) break;
-
-                    #pragma omp atomic
-                    ++active_threads;
-
+                    std::this_thread::yield();
                     continue;
                 }
 
                 int u = current.second;
-                in_queue[u].store(false);
 
-                if (current.first > distances[u]) continue;
+                // A newer entry or pop covers an improvement made after this
+                // one was queued; otherwise relax from the current distance
+                double dist_u = distances[u];
+                if (current.first > dist_u) {
+                    expanding.fetch_sub(1, std::memory_order_release);
+                    continue;
+                }
 
                 // Process neighbors
                 for (const auto& edge : graph.get_edges(u)) {
-                    double new_dist = current.first + edge.weights[0];
+                    double new_dist = dist_u + weight(edge);
 
                     if (new_dist < distances[edge.target]) {
+                        bool improved = false;
                         #pragma omp critical(distance_update)
                         {
                             if (new_dist < distances[edge.target]) {
                                 distances[edge.target] = new_dist;
                                 predecessors[edge.target] = u;
+                                improved = true;
                             }
                         }
 
-                        bool expected = false;
-                        if (in_queue[edge.target].compare_exchange_strong(expected, true)) {
+                        if (improved) {
                             std::lock_guard<std::mutex> lock(queue_mutex);
-                            global_queue.emplace(new_dist, edge.target);
+                            queue.push(edge.target, new_dist);
                         }
                     }
                 }
+                expanding.fetch_sub(1, std::memory_order_release);
             }
         }
     }
 
-    void update(const std::vector<int>& changed_edges) {
-        std::vector<bool> affected(graph.node_count(), false);
+    // Incremental repair after the out-edges of `changed_edges` (tail nodes)
+    // were inserted, deleted or re-weighted. Subtrees hanging off broken or
+    // more expensive tree edges are invalidated and re-attached, improvements
+    // are propagated from the changed nodes; the rest of the tree is kept.
+    // Returns the nodes whose predecessor may have changed.
+    std::vector<int> update(const std::vector<int>& changed_edges) {
+        const double INF = std::numeric_limits<double>::max();
+        const int n = graph.node_count();
+        if (distances.empty()) return {};
+
+        // The graph may have grown since the last compute
+        if (static_cast<int>(distances.size()) < n) {
+            distances.resize(n, INF);
+            predecessors.resize(n, -1);
+        }
+
+        std::vector<char> affected(n, 0);
         for (int e : changed_edges) {
-            affected[e] = true;
+            if (e >= 0 && e < n) affected[e] = 1;
         }
 
-        #pragma omp parallel for schedule(dynamic, 32)
-        for (int u = 0; u < graph.node_count(); ++u) {
-            if (affected[u]) {
-                for (const auto& edge : graph.get_edges(u)) {
-                    double new_dist = distances[u] + edge.weights[0];
+        // Tree edges out of changed nodes that disappeared or got more expensive
+        std::vector<int> broken;
+        #pragma omp parallel for schedule(dynamic, 256)
+        for (int v = 0; v < n; ++v) {
+            int p = predecessors[v];
+            if (p < 0 || !affected[p]) continue;
+
+            double best = INF;
+            for (const auto& edge : graph.get_edges(p)) {
+                if (edge.target == v) best = std::min(best, weight(edge));
+            }
+            if (best == INF || distances[p] + best > distances[v]) {
+                #pragma omp critical(broken_edges)
+                broken.push_back(v);
+            }
+        }
+
+        std::vector<int> touched;
+        std::vector<char> invalid(n, 0);
+        if (!broken.empty()) {
+            // Children lists of the current tree in CSR form
+            std::vector<int> child_start(n + 1, 0), children(n);
+            for (int v = 0; v < n; ++v) {
+                if (predecessors[v] >= 0) ++child_start[predecessors[v] + 1];
+            }
+            for (int v = 0; v < n; ++v) child_start[v + 1] += child_start[v];
+            std::vector<int> fill(child_start.begin(), child_start.end() - 1);
+            for (int v = 0; v < n; ++v) {
+                if (predecessors[v] >= 0) children[fill[predecessors[v]]++] = v;
+            }
+
+            // Disconnect the subtrees below broken edges
+            std::vector<int> stack(broken.begin(), broken.end());
+            while (!stack.empty()) {
+                int v = stack.back();
+                stack.pop_back();
+                if (invalid[v]) continue;
+                invalid[v] = 1;
+                touched.push_back(v);
+                for (int c = child_start[v]; c < child_start[v + 1]; ++c) {
+                    stack.push_back(children[c]);
+                }
+            }
+            for (int v : touched) {
+                distances[v] = INF;
+                predecessors[v] = -1;
+            }
+        }
+
+        // Seed the repair: best entry into the invalidated region from valid
+        // nodes, plus every improvement offered by the changed nodes
+        std::vector<std::pair<double, int>> seeds;
+        #pragma omp parallel for schedule(dynamic, 256)
+        for (int u = 0; u < n; ++u) {
+            if (distances[u] == INF || (touched.empty() && !affected[u])) continue;
+
+            for (const auto& edge : graph.get_edges(u)) {
+                if (!affected[u] && !invalid[edge.target]) continue;
+                double new_dist = distances[u] + weight(edge);
+                #pragma omp critical(distance_update)
+                {
                     if (new_dist < distances[edge.target]) {
-                        #pragma omp critical
-                        {
-                            if (new_dist < distances[edge.target]) {
-                                distances[edge.target] = new_dist;
-                                predecessors[edge.target] = u;
-                            }
-                        }
+                        distances[edge.target] = new_dist;
+                        predecessors[edge.target] = u;
+                        seeds.emplace_back(new_dist, edge.target);
                     }
                 }
             }
         }
+
+        // Propagate from the seeded nodes
+        queue.clear();
+        queue.reserve_nodes(n);
+        for (const auto& [dist, node] : seeds) {
+            if (dist == distances[node]) queue.push(node, dist);
+        }
+        while (!queue.empty()) {
+            auto [dist_u, u] = queue.pop();
+            if (dist_u > distances[u]) continue;
+            touched.push_back(u);
+
+            for (const auto& edge : graph.get_edges(u)) {
+                double new_dist = dist_u + weight(edge);
+                if (new_dist < distances[edge.target]) {
+                    distances[edge.target] = new_dist;
+                    predecessors[edge.target] = u;
+                    queue.push(edge.target, new_dist);
+                }
+            }
+        }
+
+        std::sort(touched.begin(), touched.end());
+        touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+        return touched;
     }
 
     double get_distance(int node) const {
@@ -140,4 +237,19 @@ public:
     }
 
     const std::vector<double>& get_all_distances() const { return distances; }
+
+    const std::vector<int>& get_predecessors() const { return predecessors; }
+
+    // Node sequence source -> target (empty if unreachable)
+    std::vector<int> get_path(int target) const {
+        std::vector<int> path;
+        if (get_distance(target) == std::numeric_limits<double>::max()) return path;
+        for (int node = target; node != -1; node = predecessors[node]) {
+            path.push_back(node);
+        }
+        std::reverse(path.begin(), path.end());
+        return path;
+    }
 };
+
+using SOSPEngine = BasicSOSPEngine<ObjectiveWeight>;
@@ -0,0 +1,224 @@
+#pragma once
+#include "graph.hpp"
+#include "query_pool.hpp"
+#include "indexed_heap.hpp"
+#include <vector>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <limits>
+#include <algorithm>
+#include <cstdint>
+
+// Distances and predecessors of one single-source shortest path tree
+struct ShortestPathTree {
+    std::vector<double> distances;
+    std::vector<int> predecessors;
+
+    size_t bytes() const {
+        return distances.size() * sizeof(double) + predecessors.size() * sizeof(int);
+    }
+
+    double get_distance(int node) const {
+        if (node < 0) throw std::out_of_range("Node ID out of range");
+        if (node >= static_cast<int>(distances.size())) return std::numeric_limits<double>::max();
+        return distances[node];
+    }
+
+    // Node sequence source -> target (empty if unreachable)
+    std::vector<int> get_path(int target) const {
+        std::vector<int> path;
+        if (get_distance(target) == std::numeric_limits<double>::max()) return path;
+        for (int node = target; node != -1; node = predecessors[node]) {
+            path.push_back(node);
+        }
+        std::reverse(path.begin(), path.end());
+        return path;
+    }
+};
+
+// One edge change applied to the graph. Empty old_weights means the edge was
+// inserted, empty new_weights means it was deleted.
+struct EdgeChange {
+    int src;
+    int tgt;
+    std::vector<double> old_weights;
+    std::vector<double> new_weights;
+};
+
+// LRU cache of shortest path trees keyed by (source, objective) under a
+// memory budget. After edge updates only the trees an update can affect are
+// touched: decreases are repaired incrementally, increases and deletions of tree
+// edges evict the tree.
+class SSSPCache {
+public:
+    using TreePtr = std::shared_ptr<const ShortestPathTree>;
+
+    explicit SSSPCache(size_t memory_budget_bytes) : budget(memory_budget_bytes) {}
+
+    // Cached tree or nullptr, without computing anything
+    TreePtr peek(int source, size_t objective) {
+        auto it = entries.find(make_key(source, objective));
+        if (it == entries.end()) return nullptr;
+        touch(it->second);
+        ++hits;
+        return it->second.tree;
+    }
+
+    // Cached tree, computed and inserted on a miss
+    TreePtr get(const DynamicGraph& graph, int source, size_t objective = 0) {
+        if (TreePtr tree = peek(source, objective)) return tree;
+        ++misses;
+
+        context.run(graph, source, -1, objective);
+        auto tree = std::make_shared<ShortestPathTree>();
+        tree->distances.resize(graph.node_count());
+        tree->predecessors.resize(graph.node_count());
+        for (size_t node = 0; node < graph.node_count(); ++node) {
+            tree->distances[node] = context.get_distance(node);
+            tree->predecessors[node] = context.get_predecessor(node);
+        }
+
+        insert(make_key(source, objective), tree);
+        return tree;
+    }
+
+    // Call after `changes` have been applied to `graph`
+    void apply_changes(const DynamicGraph& graph, const std::vector<EdgeChange>& changes) {
+        const double INF = std::numeric_limits<double>::max();
+
+        for (auto it = lru.begin(); it != lru.end();) {
+            Key key = *it;
+            Entry& entry = entries.at(key);
+            size_t objective = key_objective(key);
+            const ShortestPathTree& tree = *entry.tree;
+
+            bool invalid = false;
+            std::vector<int> seeds;
+            for (const auto& change : changes) {
+                double old_w = objective < change.old_weights.size() ? change.old_weights[objective] : INF;
+                double new_w = objective < change.new_weights.size() ? change.new_weights[objective] : INF;
+                double dist_src = tree.get_distance(change.src);
+
+                if (new_w > old_w) {
+                    // Only matters if the edge was part of the tree
+                    if (change.tgt < static_cast<int>(tree.predecessors.size()) &&
+                        tree.predecessors[change.tgt] == change.src) {
+                        invalid = true;
+                        break;
+                    }
+                } else if (new_w < old_w && dist_src != INF &&
+                           dist_src + new_w < tree.get_distance(change.tgt)) {
+                    seeds.push_back(change.src);
+                }
+            }
+
+            if (invalid) {
+                used_bytes -= tree.bytes();
+                entries.erase(key);
+                it = lru.erase(it);
+                ++invalidations;
+                continue;
+            }
+
+            if (!seeds.empty()) {
+                // Trees handed out earlier stay untouched; repair a private copy
+                auto repaired = std::make_shared<ShortestPathTree>(tree);
+                repair(graph, *repaired, seeds, objective);
+                used_bytes += repaired->bytes() - tree.bytes();
+                entry.tree = repaired;
+                ++repairs;
+            }
+            ++it;
+        }
+
+        evict_to_budget();
+    }
+
+    void clear() {
+        entries.clear();
+        lru.clear();
+        used_bytes = 0;
+    }
+
+    size_t size() const { return entries.size(); }
+    size_t memory_used() const { return used_bytes; }
+    size_t get_hits() const { return hits; }
+    size_t get_misses() const { return misses; }
+    size_t get_repairs() const { return repairs; }
+    size_t get_invalidations() const { return invalidations; }
+
+private:
+    using Key = uint64_t;
+
+    struct Entry {
+        TreePtr tree;
+        std::list<Key>::iterator position;
+    };
+
+    size_t budget;
+    size_t used_bytes = 0;
+    std::list<Key> lru;  // most recently used first
+    std::unordered_map<Key, Entry> entries;
+    QueryContext context;
+    IndexedDaryHeap<4> repair_heap;
+
+    size_t hits = 0, misses = 0, repairs = 0, invalidations = 0;
+
+    static Key make_key(int source, size_t objective) {
+        return (static_cast<uint64_t>(objective) << 32) | static_cast<uint32_t>(source);
+    }
+
+    static size_t key_objective(Key key) { return key >> 32; }
+
+    void touch(Entry& entry) {
+        lru.splice(lru.begin(), lru, entry.position);
+    }
+
+    void insert(Key key, TreePtr tree) {
+        // A tree larger than the whole budget is returned but not kept
+        if (tree->bytes() > budget) return;
+
+        lru.push_front(key);
+        entries[key] = {tree, lru.begin()};
+        used_bytes += tree->bytes();
+        evict_to_budget();
+    }
+
+    void evict_to_budget() {
+        while (used_bytes > budget && !lru.empty()) {
+            Key victim = lru.back();
+            used_bytes -= entries.at(victim).tree->bytes();
+            entries.erase(victim);
+            lru.pop_back();
+        }
+    }
+
+    // Dijkstra restarted from the tails of decreased edges; distances only
+    // go down, so every other entry stays valid
+    void repair(const DynamicGraph& graph, ShortestPathTree& tree,
+                const std::vector<int>& seeds, size_t objective) {
+        const double INF = std::numeric_limits<double>::max();
+        if (tree.distances.size() < graph.node_count()) {
+            tree.distances.resize(graph.node_count(), INF);
+            tree.predecessors.resize(graph.node_count(), -1);
+        }
+
+        repair_heap.clear();
+        repair_heap.reserve_nodes(graph.node_count());
+        for (int seed : seeds) repair_heap.push(seed, tree.distances[seed]);
+
+        while (!repair_heap.empty()) {
+            auto [dist_u, u] = repair_heap.pop();
+
+            for (const auto& edge : graph.get_edges(u)) {
+                double new_dist = dist_u + edge.weights[objective];
+                if (new_dist < tree.distances[edge.target]) {
+                    tree.distances[edge.target] = new_dist;
+                    tree.predecessors[edge.target] = u;
+                    repair_heap.push(edge.target, new_dist);
+                }
+            }
+        }
+    }
+};
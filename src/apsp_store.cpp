@@ -0,0 +1,92 @@
+#include "../include/apsp_store.hpp"
+#include <stdexcept>
+#include <exception>
+#include <string>
+
+APSPRowStore::APSPRowStore(const std::string& path, int node_count,
+                           MPI_Comm comm, bool cache_rows)
+    : comm(comm), file(MPI_FILE_NULL), n(node_count), is_open(false), cache_rows(cache_rows) {
+    if (node_count < 0) throw std::invalid_argument("Node count must be non-negative");
+
+    int rc = MPI_File_open(comm, path.c_str(), MPI_MODE_CREATE | MPI_MODE_RDWR,
+                           MPI_INFO_NULL, &file);
+    if (rc != MPI_SUCCESS) {
+        throw std::runtime_error("Could not open APSP output file: " + path);
+    }
+    is_open = true;
+    uncaught_at_open = std::uncaught_exceptions();
+
+    // Reserve the full matrix up front so reads of any row stay in bounds
+    if (MPI_File_set_size(file, row_offset(n)) != MPI_SUCCESS) {
+        MPI_File_close(&file);
+        is_open = false;
+        throw std::runtime_error("Could not size APSP output file: " + path);
+    }
+}
+
+APSPRowStore::~APSPRowStore() {
+    // Closing is collective, so only do it here if the caller forgot and
+    // every rank gets here the same way. During unwinding from an exception
+    // the other ranks may never reach the close; leave the handle to
+    // MPI_Abort / MPI_Finalize instead of blocking.
+    int finalized = 0;
+    MPI_Finalized(&finalized);
+    if (is_open && !finalized && std::uncaught_exceptions() == uncaught_at_open) {
+        MPI_File_close(&file);
+    }
+}
+
+MPI_Offset APSPRowStore::row_offset(int source) const {
+    return static_cast<MPI_Offset>(source) * n * static_cast<MPI_Offset>(sizeof(double));
+}
+
+void APSPRowStore::put_row(int source, const std::vector<double>& distances) {
+    if (source < 0 || source >= n) throw std::out_of_range("Source ID out of range");
+    if (static_cast<int>(distances.size()) != n) {
+        throw std::invalid_argument("Distance row must have node_count entries");
+    }
+
+    MPI_Status status;
+    int rc = MPI_File_write_at(file, row_offset(source), distances.data(), n, MPI_DOUBLE, &status);
+    int written = 0;
+    if (rc == MPI_SUCCESS) MPI_Get_count(&status, MPI_DOUBLE, &written);
+    if (rc != MPI_SUCCESS || written != n) {
+        throw std::runtime_error("Could not write APSP row " + std::to_string(source));
+    }
+    written_sources.push_back(source);
+
+    if (cache_rows) {
+        cached_rows[source] = distances;
+    }
+}
+
+void APSPRowStore::sync() {
+    // sync-barrier-sync gives read-after-write consistency across ranks
+    MPI_File_sync(file);
+    MPI_Barrier(comm);
+    MPI_File_sync(file);
+}
+
+std::vector<double> APSPRowStore::get_row(int source) {
+    if (source < 0 || source >= n) throw std::out_of_range("Source ID out of range");
+
+    auto it = cached_rows.find(source);
+    if (it != cached_rows.end()) return it->second;
+
+    std::vector<double> row(n);
+    MPI_Status status;
+    int rc = MPI_File_read_at(file, row_offset(source), row.data(), n, MPI_DOUBLE, &status);
+    int read = 0;
+    if (rc == MPI_SUCCESS) MPI_Get_count(&status, MPI_DOUBLE, &read);
+    if (rc != MPI_SUCCESS || read != n) {
+        throw std::runtime_error("Could not read APSP row " + std::to_string(source));
+    }
+    return row;
+}
+
+void APSPRowStore::close() {
+    if (!is_open) return;
+    MPI_File_close(&file);
+    is_open = false;
+    cached_rows.clear();
+}
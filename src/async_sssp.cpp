@@ -0,0 +1,324 @@
+#include "../include/async_sssp.hpp"
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+const int TOKEN_TAG = 71;
+const int DONE_TAG = 72;
+
+// Nodes popped between inbox polls; remote updates of a batch share one flush
+const int BATCH = 256;
+
+} // namespace
+
+AsyncSSSP::AsyncSSSP(const DynamicGraph& g, const std::vector<int>& node_owner,
+                     MPI_Comm communicator, size_t objective_index)
+    : graph(g), owner(node_owner), comm(communicator), objective(objective_index) {
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+
+    // Slots follow node order within each owner, so every rank can compute
+    // where a remote node lives without asking
+    capacity.assign(size, 0);
+    slot.resize(owner.size());
+    for (size_t v = 0; v < owner.size(); ++v) {
+        if (owner[v] < 0 || owner[v] >= size) throw std::invalid_argument("Node owner out of range");
+        slot[v] = capacity[owner[v]]++;
+        if (owner[v] == rank) owned.push_back(static_cast<int>(v));
+    }
+
+    const MPI_Aint slots = static_cast<MPI_Aint>(owned.size());
+    MPI_Win_allocate(slots * sizeof(DistPred), sizeof(DistPred), MPI_INFO_NULL, comm, &inbox, &inbox_win);
+    MPI_Win_allocate(slots * sizeof(int), sizeof(int), MPI_INFO_NULL, comm, &dirty, &dirty_win);
+    MPI_Win_allocate(slots * sizeof(int), sizeof(int), MPI_INFO_NULL, comm, &ring, &ring_win);
+    MPI_Win_allocate(sizeof(long long), sizeof(long long), MPI_INFO_NULL, comm, &counter, &counter_win);
+}
+
+// Collective: frees the windows
+AsyncSSSP::~AsyncSSSP() {
+    MPI_Win_free(&counter_win);
+    MPI_Win_free(&ring_win);
+    MPI_Win_free(&dirty_win);
+    MPI_Win_free(&inbox_win);
+}
+
+void AsyncSSSP::relax(int node, double dist, int pred) {
+    if (dist >= distances[node]) return;
+    distances[node] = dist;
+    predecessors[node] = pred;
+    heap.push(node, dist);
+}
+
+// Expand up to BATCH nodes. Remote improvements are accumulated into their
+// owners' inboxes and flushed before the slots are marked dirty, so whoever
+// reads a queued slot finds every update that found it dirty. Newly dirty
+// slots reserve ring entries through the owner's tail counter and are then
+// written there. Returns false if there was nothing to expand.
+bool AsyncSSSP::expand_batch() {
+    if (heap.empty()) return false;
+
+    std::vector<int> targets;
+    std::vector<DistPred> updates;
+    for (int popped = 0; popped < BATCH && !heap.empty(); ++popped) {
+        auto [dist_u, u] = heap.pop();
+        for (const auto& edge : graph.get_edges(u)) {
+            const int v = edge.target;
+            const double new_dist = dist_u + edge.weights[objective];
+            if (owner[v] == rank) {
+                relax(v, new_dist, u);
+            } else if (new_dist < sent[v]) {
+                sent[v] = new_dist;
+                targets.push_back(v);
+                updates.push_back({new_dist, u});
+            }
+        }
+    }
+    if (updates.empty()) return true;
+
+    // Origin buffers must stay put until each flush
+    for (size_t i = 0; i < updates.size(); ++i) {
+        const int v = targets[i];
+        MPI_Accumulate(&updates[i], 1, MPI_DOUBLE_INT, owner[v], slot[v], 1, MPI_DOUBLE_INT,
+                       MPI_MINLOC, inbox_win);
+    }
+    MPI_Win_flush_all(inbox_win);
+
+    const int one = 1;
+    std::vector<int> was_dirty(updates.size());
+    for (size_t i = 0; i < updates.size(); ++i) {
+        const int v = targets[i];
+        MPI_Fetch_and_op(&one, &was_dirty[i], MPI_INT, owner[v], slot[v], MPI_REPLACE, dirty_win);
+    }
+    MPI_Win_flush_all(dirty_win);
+
+    // A slot that was already dirty is still queued; its owner will see
+    // this update when it reads the slot
+    std::vector<std::vector<int>> fresh(size);
+    for (size_t i = 0; i < updates.size(); ++i) {
+        if (!was_dirty[i]) fresh[owner[targets[i]]].push_back(slot[targets[i]]);
+    }
+    std::vector<long long> reserve(size, 0), base(size, 0);
+    for (int r = 0; r < size; ++r) {
+        if (fresh[r].empty()) continue;
+        reserve[r] = static_cast<long long>(fresh[r].size());
+        MPI_Fetch_and_op(&reserve[r], &base[r], MPI_LONG_LONG, r, 0, MPI_SUM, counter_win);
+    }
+    MPI_Win_flush_all(counter_win);
+
+    // At most capacity[r] entries are reserved and unread at any time, so
+    // the reserved positions are free; write them in up to two pieces
+    for (int r = 0; r < size; ++r) {
+        if (fresh[r].empty()) continue;
+        const int count = static_cast<int>(fresh[r].size());
+        const int first = static_cast<int>(base[r] % capacity[r]);
+        const int piece = std::min(count, capacity[r] - first);
+        MPI_Accumulate(fresh[r].data(), piece, MPI_INT, r, first, piece, MPI_INT, MPI_REPLACE, ring_win);
+        if (piece < count) {
+            MPI_Accumulate(fresh[r].data() + piece, count - piece, MPI_INT, r, 0, count - piece, MPI_INT,
+                           MPI_REPLACE, ring_win);
+        }
+        sent_count += count;
+    }
+    MPI_Win_flush_all(ring_win);
+    remote_updates += updates.size();
+    return true;
+}
+
+// Pull the improvements queued in this rank's ring since the last poll. Each
+// read entry is reset before its slot is cleaned, and the slot is cleaned
+// before its value is read, so a concurrent update either lands in the value
+// read here or finds the slot clean and queues it again.
+void AsyncSSSP::poll_inbox() {
+    long long tail = 0;
+    MPI_Fetch_and_op(nullptr, &tail, MPI_LONG_LONG, rank, 0, MPI_NO_OP, counter_win);
+    MPI_Win_flush(rank, counter_win);
+    if (tail == head) return;
+
+    const int cap = static_cast<int>(owned.size());
+    const int pending = static_cast<int>(tail - head);
+    const int first = static_cast<int>(head % cap);
+    const int piece = std::min(pending, cap - first);
+    std::vector<int> entries(pending);
+    MPI_Get_accumulate(nullptr, 0, MPI_INT, entries.data(), piece, MPI_INT,
+                       rank, first, piece, MPI_INT, MPI_NO_OP, ring_win);
+    if (piece < pending) {
+        MPI_Get_accumulate(nullptr, 0, MPI_INT, entries.data() + piece, pending - piece, MPI_INT,
+                           rank, 0, pending - piece, MPI_INT, MPI_NO_OP, ring_win);
+    }
+    MPI_Win_flush(rank, ring_win);
+
+    // Entries reserved but not written yet are picked up by a later poll
+    const int ready = static_cast<int>(std::find(entries.begin(), entries.end(), -1) - entries.begin());
+    if (ready == 0) return;
+
+    const std::vector<int> unused(ready, -1);
+    const int ready_piece = std::min(ready, piece);
+    MPI_Accumulate(unused.data(), ready_piece, MPI_INT, rank, first, ready_piece, MPI_INT, MPI_REPLACE, ring_win);
+    if (ready_piece < ready) {
+        MPI_Accumulate(unused.data(), ready - ready_piece, MPI_INT, rank, 0, ready - ready_piece, MPI_INT,
+                       MPI_REPLACE, ring_win);
+    }
+    MPI_Win_flush(rank, ring_win);
+
+    const int zero = 0;
+    for (int e = 0; e < ready; ++e) {
+        MPI_Accumulate(&zero, 1, MPI_INT, rank, entries[e], 1, MPI_INT, MPI_REPLACE, dirty_win);
+    }
+    MPI_Win_flush(rank, dirty_win);
+
+    std::vector<DistPred> values(ready);
+    for (int e = 0; e < ready; ++e) {
+        MPI_Get_accumulate(nullptr, 0, MPI_DOUBLE_INT, &values[e], 1, MPI_DOUBLE_INT,
+                           rank, entries[e], 1, MPI_DOUBLE_INT, MPI_NO_OP, inbox_win);
+    }
+    MPI_Win_flush(rank, inbox_win);
+
+    // Safra: receiving makes this rank black until the token passes
+    black = true;
+    head += ready;
+    received_count += ready;
+
+    for (int e = 0; e < ready; ++e) {
+        const int node = owned[entries[e]];
+        if (values[e].dist < distances[node]) relax(node, values[e].dist, values[e].pred);
+    }
+}
+
+// Called while passive. Rank 0 launches the token and decides; the others
+// add their counts and pass it on around the ring. Returns true once the
+// computation has terminated everywhere.
+bool AsyncSSSP::handle_termination(bool& token_out, bool& holding_token, Token& token) {
+    if (size == 1) return true;
+
+    int flag = 0;
+    MPI_Status status;
+    MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, comm, &flag, &status);
+    if (flag && status.MPI_TAG == DONE_TAG) {
+        MPI_Recv(nullptr, 0, MPI_BYTE, status.MPI_SOURCE, DONE_TAG, comm, MPI_STATUS_IGNORE);
+        return true;
+    }
+    if (flag && status.MPI_TAG == TOKEN_TAG) {
+        MPI_Recv(&token, sizeof(Token), MPI_BYTE, status.MPI_SOURCE, TOKEN_TAG, comm, MPI_STATUS_IGNORE);
+        holding_token = true;
+    }
+
+    const long long balance = sent_count - received_count;
+    if (rank == 0) {
+        if (holding_token) {
+            holding_token = false;
+            token_out = false;
+            if (!token.black && !black && token.count + balance == 0) {
+                for (int r = 1; r < size; ++r) MPI_Send(nullptr, 0, MPI_BYTE, r, DONE_TAG, comm);
+                return true;
+            }
+        }
+        if (!token_out) {
+            ++token_rounds;
+            black = false;
+            Token fresh{0, 0};
+            MPI_Send(&fresh, sizeof(Token), MPI_BYTE, 1, TOKEN_TAG, comm);
+            token_out = true;
+        }
+    } else if (holding_token) {
+        token.count += balance;
+        if (black) token.black = 1;
+        black = false;
+        MPI_Send(&token, sizeof(Token), MPI_BYTE, (rank + 1) % size, TOKEN_TAG, comm);
+        holding_token = false;
+    }
+    return false;
+}
+
+void AsyncSSSP::compute(int source) {
+    const double INF = std::numeric_limits<double>::max();
+    const size_t n = graph.node_count();
+    if (owner.size() < n) throw std::invalid_argument("Owner map does not cover the graph");
+    if (source < 0 || static_cast<size_t>(source) >= n) throw std::out_of_range("Source ID out of range");
+
+    distances.assign(n, INF);
+    predecessors.assign(n, -1);
+    sent.assign(n, INF);
+    heap.clear();
+    heap.reserve_nodes(n);
+    for (size_t s = 0; s < owned.size(); ++s) {
+        inbox[s] = {INF, -1};
+        dirty[s] = 0;
+        ring[s] = -1;
+    }
+    *counter = 0;
+    head = 0;
+    sent_count = 0;
+    received_count = 0;
+    black = false;
+    token_rounds = 0;
+    remote_updates = 0;
+
+    // Only synchronization point: no rank may write an inbox before its
+    // owner has reset it
+    MPI_Barrier(comm);
+    MPI_Win_lock_all(0, inbox_win);
+    MPI_Win_lock_all(0, dirty_win);
+    MPI_Win_lock_all(0, ring_win);
+    MPI_Win_lock_all(0, counter_win);
+
+    if (owner[source] == rank) relax(source, 0.0, -1);
+
+    bool token_out = false, holding_token = false;
+    Token token{0, 0};
+    while (true) {
+        expand_batch();
+        poll_inbox();
+        if (heap.empty() && handle_termination(token_out, holding_token, token)) break;
+    }
+
+    MPI_Win_unlock_all(counter_win);
+    MPI_Win_unlock_all(ring_win);
+    MPI_Win_unlock_all(dirty_win);
+    MPI_Win_unlock_all(inbox_win);
+}
+
+double AsyncSSSP::get_distance(int node) const {
+    if (node < 0 || static_cast<size_t>(node) >= distances.size()) {
+        throw std::out_of_range("Node ID out of range");
+    }
+    return distances[node];
+}
+
+int AsyncSSSP::get_predecessor(int node) const {
+    if (node < 0 || static_cast<size_t>(node) >= predecessors.size()) {
+        throw std::out_of_range("Node ID out of range");
+    }
+    return predecessors[node];
+}
+
+void AsyncSSSP::gather(int root) {
+    // Each node is final only on its owner; everyone else contributes INF / -1
+    const int n = static_cast<int>(distances.size());
+    std::vector<double> own_distances(n, std::numeric_limits<double>::max());
+    std::vector<int> own_predecessors(n, -1);
+    for (int v : owned) {
+        if (v >= n) continue;
+        own_distances[v] = distances[v];
+        own_predecessors[v] = predecessors[v];
+    }
+
+    if (rank == root) {
+        MPI_Reduce(own_distances.data(), distances.data(), n, MPI_DOUBLE, MPI_MIN, root, comm);
+        MPI_Reduce(own_predecessors.data(), predecessors.data(), n, MPI_INT, MPI_MAX, root, comm);
+    } else {
+        MPI_Reduce(own_distances.data(), nullptr, n, MPI_DOUBLE, MPI_MIN, root, comm);
+        MPI_Reduce(own_predecessors.data(), nullptr, n, MPI_INT, MPI_MAX, root, comm);
+    }
+}
+
+std::vector<int> AsyncSSSP::get_path(int target) const {
+    std::vector<int> path;
+    if (get_distance(target) == std::numeric_limits<double>::max()) return path;
+    for (int node = target; node != -1; node = predecessors[node]) {
+        path.push_back(node);
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
@@ -0,0 +1,202 @@
+#include "../include/distributed_sssp.hpp"
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+const uint64_t NO_BUCKET = std::numeric_limits<uint64_t>::max();
+
+} // namespace
+
+DistributedSSSP::DistributedSSSP(const DynamicGraph& g, const std::vector<int>& node_owner,
+                                 MPI_Comm communicator, double bucket_width, size_t objective_index)
+    : graph(g), owner(node_owner), comm(communicator), delta(bucket_width), objective(objective_index) {
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+    outgoing.resize(size);
+
+    if (delta <= 0) {
+        // Mean weight over every rank's owned out-edges
+        double local[2] = {0.0, 0.0};
+        for (size_t v = 0; v < owner.size() && v < graph.node_count(); ++v) {
+            if (!owns(v)) continue;
+            for (const auto& edge : graph.get_edges(v)) {
+                local[0] += edge.weights[objective];
+                local[1] += 1.0;
+            }
+        }
+        double total[2];
+        MPI_Allreduce(local, total, 2, MPI_DOUBLE, MPI_SUM, comm);
+        delta = total[1] > 0 && total[0] > 0 ? total[0] / total[1] : 1.0;
+    }
+}
+
+void DistributedSSSP::relax(int node, double dist, int pred) {
+    if (dist >= distances[node]) return;
+    distances[node] = dist;
+    predecessors[node] = pred;
+    // The node may still sit in an older bucket; that entry is skipped later
+    buckets[bucket_of(dist)].push_back(node);
+}
+
+void DistributedSSSP::relax_edges(int u, bool light) {
+    const double dist_u = distances[u];
+    for (const auto& edge : graph.get_edges(u)) {
+        const double w = edge.weights[objective];
+        if ((w <= delta) != light) continue;
+        const int v = edge.target;
+        const double new_dist = dist_u + w;
+        if (owns(v)) {
+            relax(v, new_dist, u);
+        } else if (new_dist < sent[v]) {
+            // The owner ignores anything no better than what it already got
+            sent[v] = new_dist;
+            outgoing[owner[v]].push_back({new_dist, v, u});
+        }
+    }
+}
+
+void DistributedSSSP::exchange() {
+    ++exchanges;
+    // Relaxations travel as (dist, node, pred) triples of doubles; node IDs
+    // are exact in a double
+    std::vector<int> send_counts(size), recv_counts(size), send_offsets(size + 1, 0), recv_offsets(size + 1, 0);
+    for (int r = 0; r < size; ++r) {
+        send_counts[r] = static_cast<int>(outgoing[r].size() * 3);
+        send_offsets[r + 1] = send_offsets[r] + send_counts[r];
+    }
+    MPI_Alltoall(send_counts.data(), 1, MPI_INT, recv_counts.data(), 1, MPI_INT, comm);
+    for (int r = 0; r < size; ++r) recv_offsets[r + 1] = recv_offsets[r] + recv_counts[r];
+
+    std::vector<double> send_buffer(send_offsets[size]), recv_buffer(recv_offsets[size]);
+    for (int r = 0; r < size; ++r) {
+        double* out = send_buffer.data() + send_offsets[r];
+        for (const auto& relaxation : outgoing[r]) {
+            *out++ = relaxation.dist;
+            *out++ = relaxation.node;
+            *out++ = relaxation.pred;
+        }
+        outgoing[r].clear();
+    }
+
+    MPI_Alltoallv(send_buffer.data(), send_counts.data(), send_offsets.data(), MPI_DOUBLE,
+                  recv_buffer.data(), recv_counts.data(), recv_offsets.data(), MPI_DOUBLE, comm);
+
+    for (size_t i = 0; i < recv_buffer.size(); i += 3) {
+        relax(static_cast<int>(recv_buffer[i + 1]), recv_buffer[i], static_cast<int>(recv_buffer[i + 2]));
+    }
+}
+
+// Smallest bucket holding a node whose distance still maps to it; stale
+// entries and emptied buckets are dropped
+uint64_t DistributedSSSP::local_min_bucket() {
+    while (!buckets.empty()) {
+        auto it = buckets.begin();
+        auto& bucket = it->second;
+        bucket.erase(std::remove_if(bucket.begin(), bucket.end(),
+            [&](int v) { return bucket_of(distances[v]) != it->first; }), bucket.end());
+        if (!bucket.empty()) return it->first;
+        buckets.erase(it);
+    }
+    return NO_BUCKET;
+}
+
+void DistributedSSSP::compute(int source) {
+    const double INF = std::numeric_limits<double>::max();
+    const size_t n = graph.node_count();
+    if (owner.size() < n) throw std::invalid_argument("Owner map does not cover the graph");
+    if (source < 0 || static_cast<size_t>(source) >= n) throw std::out_of_range("Source ID out of range");
+
+    distances.assign(n, INF);
+    predecessors.assign(n, -1);
+    sent.assign(n, INF);
+    buckets.clear();
+    phases = 0;
+    exchanges = 0;
+
+    if (owns(source)) relax(source, 0.0, -1);
+
+    std::vector<int> frontier, settled;
+    while (true) {
+        uint64_t local_min = local_min_bucket();
+        uint64_t current = NO_BUCKET;
+        MPI_Allreduce(&local_min, &current, 1, MPI_UINT64_T, MPI_MIN, comm);
+        if (current == NO_BUCKET) break;
+        ++phases;
+
+        // Light edges until bucket `current` is empty everywhere; relaxed
+        // nodes can fall back into it
+        settled.clear();
+        int active = 1;
+        while (active) {
+            frontier.clear();
+            auto it = buckets.find(current);
+            if (it != buckets.end()) {
+                for (int v : it->second) {
+                    if (bucket_of(distances[v]) == current) frontier.push_back(v);
+                }
+                buckets.erase(it);
+            }
+            std::sort(frontier.begin(), frontier.end());
+            frontier.erase(std::unique(frontier.begin(), frontier.end()), frontier.end());
+
+            for (int u : frontier) relax_edges(u, true);
+            settled.insert(settled.end(), frontier.begin(), frontier.end());
+            exchange();
+
+            int local_active = buckets.count(current);
+            MPI_Allreduce(&local_active, &active, 1, MPI_INT, MPI_LOR, comm);
+        }
+
+        // Heavy edges land in later buckets, so one round settles them
+        std::sort(settled.begin(), settled.end());
+        settled.erase(std::unique(settled.begin(), settled.end()), settled.end());
+        for (int u : settled) relax_edges(u, false);
+        exchange();
+    }
+}
+
+double DistributedSSSP::get_distance(int node) const {
+    if (node < 0 || static_cast<size_t>(node) >= distances.size()) {
+        throw std::out_of_range("Node ID out of range");
+    }
+    return distances[node];
+}
+
+int DistributedSSSP::get_predecessor(int node) const {
+    if (node < 0 || static_cast<size_t>(node) >= predecessors.size()) {
+        throw std::out_of_range("Node ID out of range");
+    }
+    return predecessors[node];
+}
+
+void DistributedSSSP::gather(int root) {
+    // Each node is final only on its owner; everyone else contributes INF / -1
+    const int n = static_cast<int>(distances.size());
+    std::vector<double> own_distances(n, std::numeric_limits<double>::max());
+    std::vector<int> own_predecessors(n, -1);
+    for (int v = 0; v < n; ++v) {
+        if (!owns(v)) continue;
+        own_distances[v] = distances[v];
+        own_predecessors[v] = predecessors[v];
+    }
+
+    if (rank == root) {
+        MPI_Reduce(own_distances.data(), distances.data(), n, MPI_DOUBLE, MPI_MIN, root, comm);
+        MPI_Reduce(own_predecessors.data(), predecessors.data(), n, MPI_INT, MPI_MAX, root, comm);
+    } else {
+        MPI_Reduce(own_distances.data(), nullptr, n, MPI_DOUBLE, MPI_MIN, root, comm);
+        MPI_Reduce(own_predecessors.data(), nullptr, n, MPI_INT, MPI_MAX, root, comm);
+    }
+}
+
+std::vector<int> DistributedSSSP::get_path(int target) const {
+    std::vector<int> path;
+    if (get_distance(target) == std::numeric_limits<double>::max()) return path;
+    for (int node = target; node != -1; node = predecessors[node]) {
+        path.push_back(node);
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
@@ -1,4 +1,31 @@
 #include "../include/graph.hpp"
 #include <algorithm>
+#include <fstream>
+#include <sstream>
 
-// (Definitions for functions declared in graph.hpp)
\ No newline at end of file
+// (Definitions for functions declared in graph.hpp)
+
+DynamicGraph DynamicGraph::load_edge_list(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) throw std::runtime_error("Could not open graph file: " + path);
+
+    DynamicGraph graph;
+    std::string line;
+    size_t line_no = 0;
+    while (std::getline(in, line)) {
+        ++line_no;
+        if (line.empty() || line[0] == '#') continue;
+
+        std::istringstream fields(line);
+        int src, tgt;
+        if (!(fields >> src >> tgt)) {
+            throw std::runtime_error("Malformed edge on line " + std::to_string(line_no));
+        }
+
+        std::vector<double> weights;
+        double w;
+        while (fields >> w) weights.push_back(w);
+        graph.add_edge(src, tgt, weights);
+    }
+    return graph;
+}
@@ -2,6 +2,7 @@
 #include <limits>
 #include <algorithm>
 #include <iostream>
+#include <stdexcept>
 
 HybridEngine::HybridEngine(DynamicGraph& g) :
     graph(g),
@@ -103,4 +104,216 @@ std::vector<double> HybridEngine::get_distances() const {
 
 const std::vector<int>& HybridEngine::get_predecessors() const {
     return predecessors;
-}
\ No newline at end of file
+}
+
+void HybridEngine::build_halo(const std::vector<int>& owner, MPI_Comm comm) {
+    int rank, size;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+
+    halo = HaloPlan();
+    halo.owner = owner;
+    halo.rank = rank;
+    const int n = graph.node_count();
+    for (int v = 0; v < n; ++v) {
+        if (owner[v] == rank) halo.owned.push_back(v);
+    }
+
+    // Distinct remote targets per owning rank
+    std::vector<std::vector<int>> targets(size);
+    for (int u : halo.owned) {
+        for (const auto& edge : graph.get_edges(u)) {
+            if (owner[edge.target] != rank) targets[owner[edge.target]].push_back(edge.target);
+        }
+    }
+    std::vector<int> send_counts(size), recv_counts(size);
+    for (int r = 0; r < size; ++r) {
+        std::sort(targets[r].begin(), targets[r].end());
+        targets[r].erase(std::unique(targets[r].begin(), targets[r].end()), targets[r].end());
+        send_counts[r] = targets[r].size();
+    }
+
+    // Receivers learn which of their nodes each sender will report, in order
+    MPI_Alltoall(send_counts.data(), 1, MPI_INT, recv_counts.data(), 1, MPI_INT, comm);
+    std::vector<int> send_offsets(size + 1, 0), recv_offsets(size + 1, 0);
+    for (int r = 0; r < size; ++r) {
+        send_offsets[r + 1] = send_offsets[r] + send_counts[r];
+        recv_offsets[r + 1] = recv_offsets[r] + recv_counts[r];
+    }
+    std::vector<int> send_lists(send_offsets[size]), recv_lists(recv_offsets[size]);
+    for (int r = 0; r < size; ++r) {
+        std::copy(targets[r].begin(), targets[r].end(), send_lists.begin() + send_offsets[r]);
+    }
+    MPI_Alltoallv(send_lists.data(), send_counts.data(), send_offsets.data(), MPI_INT,
+                  recv_lists.data(), recv_counts.data(), recv_offsets.data(), MPI_INT, comm);
+
+    std::vector<int> send_index(size, -1);
+    for (int r = 0; r < size; ++r) {
+        if (send_counts[r] > 0) {
+            send_index[r] = halo.send_ranks.size();
+            halo.send_ranks.push_back(r);
+            halo.send_targets.push_back(std::move(targets[r]));
+        }
+        if (recv_counts[r] > 0) {
+            halo.recv_ranks.push_back(r);
+            halo.recv_targets.emplace_back(recv_lists.begin() + recv_offsets[r],
+                                           recv_lists.begin() + recv_offsets[r + 1]);
+        }
+    }
+
+    halo.cross_edges.resize(halo.send_ranks.size());
+    for (int u : halo.owned) {
+        for (const auto& edge : graph.get_edges(u)) {
+            int r = owner[edge.target];
+            if (r == rank) continue;
+            const auto& list = halo.send_targets[send_index[r]];
+            int slot = std::lower_bound(list.begin(), list.end(), edge.target) - list.begin();
+            halo.cross_edges[send_index[r]].push_back({u, edge.weights[0], slot});
+        }
+    }
+}
+
+// Bellman-Ford sweeps over edges between owned nodes until nothing changes.
+// Between sweeps the master tests the `pending` halo requests, so large
+// (rendezvous) messages progress behind the interior work instead of only
+// once the caller waits. Returns true if any distance improved.
+bool HybridEngine::relax_interior(std::vector<MPI_Request>& pending) {
+    const std::vector<int>& owned = halo.owned;
+    bool any = false, changed = true;
+    int completed = pending.empty();
+    while (changed) {
+        if (!completed) MPI_Testall(pending.size(), pending.data(), &completed, MPI_STATUSES_IGNORE);
+
+        changed = false;
+        #pragma omp parallel for schedule(dynamic, 256) reduction(||:changed)
+        for (size_t i = 0; i < owned.size(); ++i) {
+            const int u = owned[i];
+            double dist_u = atomic_distances[u].load(std::memory_order_acquire);
+            if (dist_u == std::numeric_limits<double>::max()) continue;
+
+            for (const auto& edge : graph.get_edges(u)) {
+                if (halo.owner[edge.target] != halo.rank) continue;
+                if (lower_distance(edge.target, dist_u + edge.weights[0], u)) changed = true;
+            }
+        }
+        any = any || changed;
+    }
+    return any;
+}
+
+// Atomic min on a node's distance; safe from any thread
+bool HybridEngine::lower_distance(int node, double dist, int pred) {
+    double old_dist = atomic_distances[node].load(std::memory_order_acquire);
+    while (dist < old_dist) {
+        if (atomic_distances[node].compare_exchange_weak(old_dist, dist, std::memory_order_acq_rel)) {
+            #pragma omp critical
+            {
+                predecessors[node] = pred;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+void HybridEngine::compute_distributed(int source, const std::vector<int>& owner, MPI_Comm comm) {
+    const double INF = std::numeric_limits<double>::max();
+    const int HALO_TAG = 91;
+    const int n = graph.node_count();
+    if (source < 0 || source >= n) throw std::out_of_range("Source ID out of range");
+    if (static_cast<int>(owner.size()) < n) throw std::invalid_argument("Owner map does not cover the graph");
+
+    int rank;
+    MPI_Comm_rank(comm, &rank);
+    // The plan depends only on the owner map; every rank sees the same map,
+    // so they all rebuild (collectively) or none does
+    if (halo.owner != owner) build_halo(owner, comm);
+
+    // Threads may only call MPI themselves if the library allows it
+    int provided = MPI_THREAD_SINGLE;
+    MPI_Query_thread(&provided);
+    multiple_active = thread_multiple && provided == MPI_THREAD_MULTIPLE;
+    const bool multiple = multiple_active;
+
+    if (static_cast<int>(atomic_distances.size()) != n) {
+        atomic_distances = std::vector<std::atomic<double>>(n);
+    }
+    #pragma omp parallel for
+    for (int v = 0; v < n; ++v) {
+        atomic_distances[v].store(INF, std::memory_order_relaxed);
+    }
+    predecessors.assign(n, -1);
+    if (owner[source] == rank) atomic_distances[source].store(0.0, std::memory_order_relaxed);
+
+    const size_t sends = halo.send_ranks.size(), recvs = halo.recv_ranks.size();
+    std::vector<std::vector<double>> send_buffers(sends), recv_buffers(recvs);
+    for (size_t i = 0; i < recvs; ++i) recv_buffers[i].resize(2 * halo.recv_targets[i].size());
+    std::vector<MPI_Request> requests(sends + recvs);
+
+    distributed_iterations = 0;
+    int global_changed = 1;
+    while (global_changed) {
+        ++distributed_iterations;
+
+        for (size_t i = 0; i < recvs; ++i) {
+            MPI_Irecv(recv_buffers[i].data(), recv_buffers[i].size(), MPI_DOUBLE,
+                      halo.recv_ranks[i], HALO_TAG, comm, &requests[sends + i]);
+        }
+
+        // Boundary values from the distances settled so far. With
+        // MPI_THREAD_MULTIPLE each thread sends its buffers as soon as they
+        // are packed; otherwise the master sends them all afterwards.
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (size_t i = 0; i < sends; ++i) {
+            std::vector<double>& buffer = send_buffers[i];
+            buffer.assign(2 * halo.send_targets[i].size(), INF);
+            for (size_t s = 1; s < buffer.size(); s += 2) buffer[s] = -1;
+            for (const auto& cross : halo.cross_edges[i]) {
+                double dist_u = atomic_distances[cross.u].load(std::memory_order_relaxed);
+                if (dist_u == INF) continue;
+                double value = dist_u + cross.weight;
+                if (value < buffer[2 * cross.slot]) {
+                    buffer[2 * cross.slot] = value;
+                    buffer[2 * cross.slot + 1] = cross.u;
+                }
+            }
+            if (multiple) {
+                MPI_Isend(buffer.data(), buffer.size(), MPI_DOUBLE,
+                          halo.send_ranks[i], HALO_TAG, comm, &requests[i]);
+            }
+        }
+
+        if (!multiple) {
+            for (size_t i = 0; i < sends; ++i) {
+                MPI_Isend(send_buffers[i].data(), send_buffers[i].size(), MPI_DOUBLE,
+                          halo.send_ranks[i], HALO_TAG, comm, &requests[i]);
+            }
+        }
+
+        // Interior work needs no remote data and hides the exchange
+        bool changed = relax_interior(requests);
+
+        // Boundary nodes take the best value offered by other ranks; with
+        // MPI_THREAD_MULTIPLE each thread waits for and applies its own
+        // neighbours' halos
+        if (!multiple) {
+            MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+        }
+        #pragma omp parallel for schedule(dynamic, 1) reduction(||:changed) if(multiple)
+        for (size_t i = 0; i < recvs; ++i) {
+            if (multiple) MPI_Wait(&requests[sends + i], MPI_STATUS_IGNORE);
+            const std::vector<int>& nodes = halo.recv_targets[i];
+            for (size_t k = 0; k < nodes.size(); ++k) {
+                int pred = static_cast<int>(recv_buffers[i][2 * k + 1]);
+                if (lower_distance(nodes[k], recv_buffers[i][2 * k], pred)) changed = true;
+            }
+        }
+        if (multiple) {
+            MPI_Waitall(sends, requests.data(), MPI_STATUSES_IGNORE);
+        }
+
+        // Quiet everywhere means the halo just sent was already final
+        int local_changed = changed;
+        MPI_Allreduce(&local_changed, &global_changed, 1, MPI_INT, MPI_LOR, comm);
+    }
+}
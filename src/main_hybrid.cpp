@@ -1,16 +1,38 @@
 #include "../include/hybrid_engine.hpp"
 #include "../include/mpi_distributor.hpp"
+#include "../include/apsp_store.hpp"
+#include "../include/query_scheduler.hpp"
+#include "../include/distributed_sssp.hpp"
 #include <mpi.h>
 #include <iostream>
 #include <chrono>
 #include <limits>
 #include <vector>
-#include <map>
-
+#include <string>
+#include <algorithm>
+
+// Largest graph whose distance matrix is echoed to stdout
+const int MAX_PRINTED_NODES = 16;
+
+// Sources claimed per scheduler request
+const int SOURCE_CHUNK = 4;
+
+// Usage: mosp_hybrid [--thread-multiple] [output_file]
+//        mosp_hybrid [--thread-multiple] --sssp <source> [halo]
+// The all-pairs result is written to output_file (default apsp_distances.bin).
+// --sssp runs one distributed query over the rank partitions instead and
+// prints its distances: delta-stepping by default, or the hybrid engine's
+// overlapped halo exchange with "halo".
+// --thread-multiple requests MPI_THREAD_MULTIPLE so OpenMP threads post and
+// complete their own halo messages; with less thread support the run falls
+// back to MPI_THREAD_FUNNELED.
 int main(int argc, char** argv) {
+    bool want_multiple = argc > 1 && std::string(argv[1]) == "--thread-multiple";
+    const int first_arg = want_multiple ? 2 : 1;
+
     // Initialize MPI with thread support
     int provided;
-    MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided);
+    MPI_Init_thread(&argc, &argv, want_multiple ? MPI_THREAD_MULTIPLE : MPI_THREAD_FUNNELED, &provided);
     if (provided < MPI_THREAD_FUNNELED) {
         std::cerr << "ERROR: Insufficient MPI thread support\n";
         MPI_Abort(MPI_COMM_WORLD, 1);
@@ -20,13 +42,25 @@ int main(int argc, char** argv) {
     MPI_Comm_rank(MPI_COMM_WORLD, &rank);
     MPI_Comm_size(MPI_COMM_WORLD, &size);
 
+    const bool thread_multiple = provided == MPI_THREAD_MULTIPLE;
+    if (want_multiple && !thread_multiple && rank == 0) {
+        std::cout << "MPI_THREAD_MULTIPLE not available, falling back to MPI_THREAD_FUNNELED\n";
+    }
+
+    std::string output_path = "apsp_distances.bin";
+    int sssp_source = -1;
+    bool halo_sssp = false;
+    if (argc > first_arg + 1 && std::string(argv[first_arg]) == "--sssp") {
+        sssp_source = std::stoi(argv[first_arg + 1]);
+        halo_sssp = argc > first_arg + 2 && std::string(argv[first_arg + 2]) == "halo";
+    } else if (argc > first_arg) {
+        output_path = argv[first_arg];
+    }
+
     if (rank == 0) {
         std::cout << "Initializing graph with " << size << " MPI processes\n";
     }
 
-    // Add MPI barrier to ensure all processes are ready before proceeding
-    MPI_Barrier(MPI_COMM_WORLD);
-
     // Initialize a simple 4-node graph
     DynamicGraph graph(4);
     const std::vector<std::tuple<int, int, std::vector<double>>> edges = {
@@ -46,9 +80,6 @@ int main(int argc, char** argv) {
                   << graph.edge_count() << " edges\n";
     }
 
-    // Add barrier to ensure graph is fully initialized on all processes
-    MPI_Barrier(MPI_COMM_WORLD);
-
     try {
         // Partition the graph
         MPIDistributor distributor(graph);
@@ -61,148 +92,106 @@ int main(int argc, char** argv) {
         if (rank == 0) {
             std::cout << "Partition complete.\n";
         }
-        
-        // Add barrier after partition to ensure all processes are ready
-        MPI_Barrier(MPI_COMM_WORLD);
 
         DynamicGraph& local_graph = distributor.get_local_partition();
         std::cout << "Rank " << rank << " got " << local_graph.node_count() 
                 << " local nodes\n";
         std::cout.flush();
-        
-        // Add barrier after reporting local graph info
-        MPI_Barrier(MPI_COMM_WORLD);
 
-        // Hybrid computation
-        HybridEngine engine(local_graph);
-
-        // Map to store all local node distances
-        std::map<int, std::vector<double>> node_distances;
-        
-        // Get global node mapping (original node IDs)
-        std::vector<int> local_nodes;
-        for (size_t i = 0; i < local_graph.node_count(); ++i) {
-            // Only compute for nodes that actually belong to this partition
-            if (local_graph.get_partition(i) == rank) {
-                local_nodes.push_back(i);
+        if (sssp_source >= 0) {
+            // Each rank relaxes only the nodes of its own partition
+            const std::vector<int>& owner = distributor.get_node_partitions();
+            const int n = graph.node_count();
+            std::vector<double> distances(n);
+            if (halo_sssp) {
+                HybridEngine halo_engine(local_graph);
+                halo_engine.set_thread_multiple(thread_multiple);
+                halo_engine.compute_distributed(sssp_source, owner);
+                std::vector<double> local = halo_engine.get_distances();
+                for (int v = 0; v < n; ++v) {
+                    if (owner[v] != rank) local[v] = std::numeric_limits<double>::max();
+                }
+                MPI_Reduce(local.data(), distances.data(), n, MPI_DOUBLE, MPI_MIN, 0, MPI_COMM_WORLD);
+            } else {
+                DistributedSSSP sssp(local_graph, owner);
+                sssp.compute(sssp_source);
+                sssp.gather(0);
+                for (int v = 0; rank == 0 && v < n; ++v) distances[v] = sssp.get_distance(v);
             }
-        }
-
-        // Each rank computes paths for one specific node in the graph
-        // For small graphs like this, it's more efficient to have each rank focus on a single source node
-        int local_node_count = local_nodes.size();
-        if (local_node_count > 0) {
-            // For this particular example where we have a small graph:
-            // Have each rank compute shortest paths for the node matching its rank (if it exists)
-            // This ensures we get comprehensive results across all nodes
-            for (int i = 0; i < local_node_count; ++i) {
-                int node_id = local_nodes[i];
-                
-                // For small graphs, have each rank compute paths for all nodes
-                // This ensures we get complete solutions even with limited node distribution
-                if (graph.node_count() <= 8) {  // Fixed: replaced original_graph with graph
-                    for (size_t src = 0; src < graph.node_count(); ++src) {  // Fixed: replaced original_graph with graph
-                        // Only process this source if it's assigned to this rank
-                        // or if this rank needs to handle more sources
-                        if (local_graph.get_partition(src) == rank ||  // Fixed: replaced node_partitions with local_graph.get_partition
-                            (i == 0 && src % size == rank)) {
-                            engine.compute_parallel(src);
-                            node_distances[src] = engine.get_distances();
-                            std::cout << "Rank " << rank << " computed paths for node " << src << "\n";
-                            std::cout.flush();
-                        }
-                    }
-                } else {
-                    // For larger graphs, use the original approach
-                    engine.compute_parallel(node_id);
-                    node_distances[node_id] = engine.get_distances();
-                    
-                    // Add some debug output
-                    if (i % 5 == 0 || i == local_node_count - 1) {
-                        std::cout << "Rank " << rank << " computed paths for node " << node_id << "\n";
-                        std::cout.flush();
+            if (rank == 0) {
+                std::cout << "=== Distances from Node " << sssp_source << " ===\n";
+                for (int v = 0; v < n; ++v) {
+                    double dist = distances[v];
+                    if (dist == std::numeric_limits<double>::max()) {
+                        std::cout << "  Node " << v << ": INFINITY\n";
+                    } else {
+                        std::cout << "  Node " << v << ": " << dist << "\n";
                     }
                 }
             }
-        } else {
-            std::cout << "Rank " << rank << " has no local nodes to process.\n";
-            std::cout.flush();
-        }
-
-        // Add barrier before synchronization
-        MPI_Barrier(MPI_COMM_WORLD);
-        
-        if (rank == 0) {
-            std::cout << "Starting boundary synchronization...\n";
-        }
-        
-        // Synchronize boundaries
-        distributor.synchronize_boundaries();
-        
-        if (rank == 0) {
-            std::cout << "Boundary synchronization complete.\n";
+            MPI_Finalize();
+            return 0;
         }
 
-        // Add barrier after synchronization
-        MPI_Barrier(MPI_COMM_WORLD);
+        // Hybrid computation. Every rank holds the full graph, so any rank can
+        // answer any source and sources can move between ranks freely.
+        HybridEngine engine(graph);
 
-        // Initialize with maximum distance values
+        // Distance rows go straight to the shared output file; no rank keeps
+        // more than the rows it computed
         int graph_size = graph.node_count();
-        std::vector<double> result_matrix(graph_size * graph_size, std::numeric_limits<double>::max());
-        std::vector<double> global_matrix(graph_size * graph_size, std::numeric_limits<double>::max());
-        
-        // Fill the local distance matrix with computed results
-        for (const auto& [source, distances] : node_distances) {
-            for (size_t target = 0; target < distances.size(); ++target) {
-                if (distances[target] != std::numeric_limits<double>::max()) {
-                    // Use matrix indexing: source*size + target
-                    result_matrix[source * graph_size + target] = distances[target];
-                }
-            }
-        }
-        
-        std::cout << "Rank " << rank << " before Allreduce, local matrix size: " << result_matrix.size() 
-                << ", global matrix size: " << global_matrix.size() << std::endl;
-        
-        // Debug output of local distance matrix
-        std::cout << "Rank " << rank << " local distances: ";
-        for (size_t i = 0; i < local_nodes.size(); ++i) {
-            int source = local_nodes[i];
-            std::cout << "\nFrom node " << source << ": ";
-            for (size_t j = 0; j < graph_size; ++j) {
-                double dist = result_matrix[source * graph_size + j];
-                if (dist == std::numeric_limits<double>::max())
-                    std::cout << "INF ";
-                else
-                    std::cout << dist << " ";
+        APSPRowStore store(output_path, graph_size, MPI_COMM_WORLD);
+
+        // Order sources by partition so each rank's home block roughly matches
+        // the partition it owns; idle ranks steal the rest
+        std::vector<int> sources(graph_size);
+        for (int src = 0; src < graph_size; ++src) sources[src] = src;
+        std::stable_sort(sources.begin(), sources.end(), [&](int a, int b) {
+            return graph.get_partition(a) < graph.get_partition(b);
+        });
+
+        WorkStealingScheduler scheduler(MPI_COMM_WORLD, SOURCE_CHUNK);
+        size_t computed = scheduler.run(sources, [&](int src) {
+            engine.compute_parallel(src);
+            store.put_row(src, engine.get_distances());
+
+            if (graph_size <= 8) {
+                std::cout << "Rank " << rank << " computed paths for node " << src << "\n";
+                std::cout.flush();
             }
-        }
-        std::cout << std::endl;
+        });
+
+        std::cout << "Rank " << rank << " computed " << computed << " sources ("
+                  << scheduler.get_stolen_count() << " stolen)\n";
         std::cout.flush();
-        
-        // Make sure all processes have the same size arrays for reduction
-        MPI_Barrier(MPI_COMM_WORLD);
 
-        // Use MPI_Allreduce to combine results
-        MPI_Allreduce(result_matrix.data(), global_matrix.data(), graph_size * graph_size,
-                   MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD);
+        // Make every rank's rows readable from the shared file
+        store.sync();
 
-        // Final output
+        // Final output: rows are fetched on demand, only printed for small graphs
         if (rank == 0) {
-            std::cout << "=== Final Results ===\n";
-            for (int i = 0; i < graph_size; ++i) {
-                std::cout << "Distances from Node " << i << ":\n";
-                for (int j = 0; j < graph_size; ++j) {
-                    double dist = global_matrix[i * graph_size + j];
-                    if (dist == std::numeric_limits<double>::max()) {
-                        std::cout << "  Node " << j << ": INFINITY\n";
-                    } else {
-                        std::cout << "  Node " << j << ": " << dist << "\n";
+            std::cout << "=== Final Results (" << output_path << ") ===\n";
+            if (graph_size <= MAX_PRINTED_NODES) {
+                for (int i = 0; i < graph_size; ++i) {
+                    std::vector<double> row = store.get_row(i);
+                    std::cout << "Distances from Node " << i << ":\n";
+                    for (int j = 0; j < graph_size; ++j) {
+                        double dist = row[j];
+                        if (dist == std::numeric_limits<double>::max()) {
+                            std::cout << "  Node " << j << ": INFINITY\n";
+                        } else {
+                            std::cout << "  Node " << j << ": " << dist << "\n";
+                        }
                     }
+                    std::cout << std::endl;
                 }
-                std::cout << std::endl;
+            } else {
+                std::cout << graph_size << " x " << graph_size
+                          << " distance matrix written (row-major doubles)\n";
             }
         }
+
+        store.close();
     }
     catch (const std::exception& e) {
         std::cerr << "Rank " << rank << " caught exception: " << e.what() << std::endl;
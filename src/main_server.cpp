@@ -0,0 +1,58 @@
+#include "../include/query_server.hpp"
+#include <iostream>
+#include <string>
+#include <cstdlib>
+
+// Usage: mosp_server <graph_file> [--parts N] [--threads T] [--socket PATH] [--cache-mb M]
+// Loads and partitions the graph once, then answers requests on stdin/stdout
+// (or on a Unix domain socket) until SHUTDOWN. See query_server.hpp for the
+// protocol.
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0]
+                  << " <graph_file> [--parts N] [--threads T] [--socket PATH] [--cache-mb M]\n";
+        return 1;
+    }
+
+    std::string graph_path = argv[1];
+    std::string socket_path;
+    int parts = 1;
+    int threads = omp_get_max_threads();
+    size_t cache_mb = 64;
+
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--parts" && i + 1 < argc) {
+            parts = std::atoi(argv[++i]);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = std::atoi(argv[++i]);
+        } else if (arg == "--cache-mb" && i + 1 < argc) {
+            cache_mb = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--socket" && i + 1 < argc) {
+            socket_path = argv[++i];
+        } else {
+            std::cerr << "Unknown argument: " << arg << "\n";
+            return 1;
+        }
+    }
+
+    try {
+        // Status goes to stderr; stdout is the protocol channel
+        QueryServer server(DynamicGraph::load_edge_list(graph_path), parts, threads,
+                           cache_mb << 20);
+        std::cerr << "Loaded graph with " << server.get_graph().node_count() << " nodes and "
+                  << server.get_graph().edge_count() << " edges\n";
+
+        if (socket_path.empty()) {
+            server.serve(std::cin, std::cout);
+        } else {
+            std::cerr << "Listening on " << socket_path << "\n";
+            server.serve_unix_socket(socket_path);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Server error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -159,4 +159,8 @@ DynamicGraph& MPIDistributor::get_local_partition() {
 
 const std::unordered_map<int, std::vector<int>>& MPIDistributor::get_boundary_nodes() const {
     return boundary_nodes;
+}
+
+const std::vector<int>& MPIDistributor::get_node_partitions() const {
+    return node_partitions;
 }
\ No newline at end of file
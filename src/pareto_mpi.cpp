@@ -0,0 +1,129 @@
+#include "../include/pareto_mpi.hpp"
+#include "../include/pareto_utils.hpp"
+#include <stdexcept>
+#include <algorithm>
+#include <limits>
+
+namespace Pareto {
+
+std::vector<double> serialize_front(const std::vector<PathResult>& front) {
+    size_t length = 1;
+    for (const auto& path : front) length += 2 + path.objectives.size() + path.nodes.size();
+
+    std::vector<double> buffer;
+    buffer.reserve(length);
+    buffer.push_back(static_cast<double>(front.size()));
+    for (const auto& path : front) {
+        buffer.push_back(static_cast<double>(path.objectives.size()));
+        buffer.push_back(static_cast<double>(path.nodes.size()));
+        buffer.insert(buffer.end(), path.objectives.begin(), path.objectives.end());
+        // Node IDs are exact in a double up to 2^53
+        buffer.insert(buffer.end(), path.nodes.begin(), path.nodes.end());
+    }
+    return buffer;
+}
+
+std::vector<PathResult> deserialize_front(const double* buffer) {
+    size_t count = static_cast<size_t>(buffer[0]);
+    const double* p = buffer + 1;
+
+    std::vector<PathResult> front(count);
+    for (auto& path : front) {
+        size_t objectives = static_cast<size_t>(p[0]);
+        size_t nodes = static_cast<size_t>(p[1]);
+        p += 2;
+        path.objectives.assign(p, p + objectives);
+        p += objectives;
+        path.nodes.reserve(nodes);
+        for (size_t i = 0; i < nodes; ++i) path.nodes.push_back(static_cast<int>(p[i]));
+        p += nodes;
+    }
+    return front;
+}
+
+namespace {
+
+// MPI_User_function: inout = merge(in, inout). Each element is one front
+// buffer; its capacity in doubles comes from the datatype size.
+void merge_front_op(void* in, void* inout, int* len, MPI_Datatype* datatype) {
+    int type_bytes = 0;
+    MPI_Type_size(*datatype, &type_bytes);
+    const size_t capacity = static_cast<size_t>(type_bytes) / sizeof(double);
+
+    for (int e = 0; e < *len; ++e) {
+        const double* lower = static_cast<const double*>(in) + e * capacity;
+        double* upper = static_cast<double*>(inout) + e * capacity;
+
+        // `in` comes from the lower ranks; keep its paths first
+        std::vector<PathResult> merged = deserialize_front(lower);
+        std::vector<PathResult> other = deserialize_front(upper);
+        merged.insert(merged.end(), std::make_move_iterator(other.begin()),
+                      std::make_move_iterator(other.end()));
+        filter_dominated(merged);
+
+        std::vector<double> buffer = serialize_front(merged);
+        if (buffer.size() > capacity) {
+            // Cannot happen: the capacity bounds the union of all fronts
+            MPI_Abort(MPI_COMM_WORLD, 1);
+        }
+        std::copy(buffer.begin(), buffer.end(), upper);
+    }
+}
+
+// Shared set-up for reduce/allreduce: a padded local buffer and a
+// contiguous datatype covering one whole front
+struct FrontReduction {
+    std::vector<double> send;
+    std::vector<double> recv;
+    MPI_Datatype type = MPI_DATATYPE_NULL;
+    MPI_Op op = MPI_OP_NULL;
+
+    FrontReduction(const std::vector<PathResult>& local, MPI_Comm comm) {
+        // Filter first so a single rank also returns a clean front
+        std::vector<PathResult> front = local;
+        filter_dominated(front);
+        send = serialize_front(front);
+
+        long long local_size = static_cast<long long>(send.size());
+        long long capacity = 0;
+        MPI_Allreduce(&local_size, &capacity, 1, MPI_LONG_LONG, MPI_SUM, comm);
+        if (capacity > std::numeric_limits<int>::max()) {
+            throw std::length_error("Serialized Pareto fronts exceed the MPI count limit");
+        }
+
+        send.resize(capacity, 0.0);
+        recv.assign(capacity, 0.0);
+
+        MPI_Type_contiguous(static_cast<int>(capacity), MPI_DOUBLE, &type);
+        MPI_Type_commit(&type);
+        // Not commutative, so the result keeps rank order
+        MPI_Op_create(&merge_front_op, 0, &op);
+    }
+
+    ~FrontReduction() {
+        MPI_Op_free(&op);
+        MPI_Type_free(&type);
+    }
+};
+
+} // namespace
+
+std::vector<PathResult> reduce_front(const std::vector<PathResult>& local, int root, MPI_Comm comm) {
+    FrontReduction reduction(local, comm);
+    MPI_Reduce(reduction.send.data(), reduction.recv.data(), 1,
+               reduction.type, reduction.op, root, comm);
+
+    int rank;
+    MPI_Comm_rank(comm, &rank);
+    if (rank != root) return {};
+    return deserialize_front(reduction.recv.data());
+}
+
+std::vector<PathResult> allreduce_front(const std::vector<PathResult>& local, MPI_Comm comm) {
+    FrontReduction reduction(local, comm);
+    MPI_Allreduce(reduction.send.data(), reduction.recv.data(), 1,
+                  reduction.type, reduction.op, comm);
+    return deserialize_front(reduction.recv.data());
+}
+
+} // namespace Pareto
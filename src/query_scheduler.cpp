@@ -0,0 +1,62 @@
+#include "../include/query_scheduler.hpp"
+#include <stdexcept>
+#include <algorithm>
+
+WorkStealingScheduler::WorkStealingScheduler(MPI_Comm comm, int chunk_size)
+    : comm(comm), chunk_size(chunk_size), stolen(0) {
+    if (chunk_size < 1) throw std::invalid_argument("Chunk size must be positive");
+}
+
+int64_t WorkStealingScheduler::block_begin(int64_t n, int nranks, int r) {
+    return n * r / nranks;
+}
+
+size_t WorkStealingScheduler::run(const std::vector<int>& tasks,
+                                  const std::function<void(int)>& process) {
+    int rank, size;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+
+    const int64_t n = tasks.size();
+    stolen = 0;
+
+    // One counter per rank: the next unclaimed index of its home block
+    int64_t* counter = nullptr;
+    MPI_Win win;
+    MPI_Win_allocate(sizeof(int64_t), sizeof(int64_t), MPI_INFO_NULL, comm, &counter, &win);
+    *counter = block_begin(n, size, rank);
+
+    MPI_Win_lock_all(0, win);
+    MPI_Win_sync(win);
+    MPI_Barrier(comm);
+
+    size_t executed = 0;
+    const int64_t chunk = chunk_size;
+
+    // Own block first, then every other rank starting from the next one so
+    // thieves spread out instead of all hitting rank 0
+    for (int step = 0; step < size; ++step) {
+        int victim = (rank + step) % size;
+        int64_t end = block_begin(n, size, victim + 1);
+
+        while (true) {
+            int64_t first = 0;
+            MPI_Fetch_and_op(&chunk, &first, MPI_INT64_T, victim, 0, MPI_SUM, win);
+            MPI_Win_flush(victim, win);
+
+            // Counters only grow, so an exhausted block stays exhausted
+            if (first >= end) break;
+
+            int64_t last = std::min(first + chunk, end);
+            for (int64_t i = first; i < last; ++i) {
+                process(tasks[i]);
+            }
+            executed += last - first;
+            if (victim != rank) stolen += last - first;
+        }
+    }
+
+    MPI_Win_unlock_all(win);
+    MPI_Win_free(&win);
+    return executed;
+}
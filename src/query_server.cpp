@@ -0,0 +1,370 @@
+#include "../include/query_server.hpp"
+#include "../include/metis_utils.hpp"
+#include <sstream>
+#include <iomanip>
+#include <limits>
+#include <cstring>
+#include <cerrno>
+#include <stdexcept>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+// Minimal streambuf over a connected socket so sessions can use iostreams
+class SocketStreamBuf : public std::streambuf {
+    int fd;
+    char in_buf[4096];
+    char out_buf[4096];
+
+public:
+    explicit SocketStreamBuf(int fd) : fd(fd) {
+        setg(in_buf, in_buf, in_buf);
+        setp(out_buf, out_buf + sizeof(out_buf));
+    }
+
+    ~SocketStreamBuf() override { sync(); }
+
+protected:
+    int_type underflow() override {
+        ssize_t n;
+        do {
+            n = ::read(fd, in_buf, sizeof(in_buf));
+        } while (n < 0 && errno == EINTR);
+        if (n <= 0) return traits_type::eof();
+
+        setg(in_buf, in_buf, in_buf + n);
+        return traits_type::to_int_type(*gptr());
+    }
+
+    int_type overflow(int_type ch) override {
+        if (sync() == -1) return traits_type::eof();
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    int sync() override {
+        char* p = pbase();
+        while (p < pptr()) {
+            ssize_t n = ::send(fd, p, pptr() - p, MSG_NOSIGNAL);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return -1;
+            p += n;
+        }
+        setp(out_buf, out_buf + sizeof(out_buf));
+        return 0;
+    }
+};
+
+void write_distance(std::ostream& out, double dist) {
+    if (dist == std::numeric_limits<double>::max()) {
+        out << "INF";
+    } else {
+        out << dist;
+    }
+}
+
+size_t min_edge_weights(const DynamicGraph& graph) {
+    size_t min_weights = std::numeric_limits<size_t>::max();
+    for (size_t u = 0; u < graph.node_count(); ++u) {
+        for (const auto& edge : graph.get_edges(u)) {
+            min_weights = std::min(min_weights, edge.weights.size());
+        }
+    }
+    return min_weights;
+}
+
+} // namespace
+
+QueryServer::QueryServer(DynamicGraph g, int num_partitions, int num_threads, size_t cache_bytes)
+    : graph(std::move(g)), pool(graph, num_threads), cache(cache_bytes), num_partitions(num_partitions) {
+    num_objectives = min_edge_weights(graph);
+
+    // Partition once up front instead of on every batch
+    if (num_partitions > 1 && graph.node_count() > 0) {
+        MetisUtils::partition_graph(graph, num_partitions);
+    }
+}
+
+void QueryServer::check_node(int node) const {
+    if (node < 0 || node >= static_cast<int>(graph.node_count())) {
+        throw std::out_of_range("node " + std::to_string(node) + " out of range");
+    }
+}
+
+void QueryServer::check_objective(size_t objective) const {
+    if (objective >= num_objectives) {
+        throw std::out_of_range("objective " + std::to_string(objective) + " out of range");
+    }
+}
+
+bool QueryServer::serve(std::istream& in, std::ostream& out) {
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream args(line);
+        std::string command;
+        if (!(args >> command)) continue;
+
+        if (command == "QUIT" || command == "SHUTDOWN") {
+            out << "BYE" << std::endl;
+            return command == "QUIT";
+        }
+
+        // Sessions share the graph, cache and pool, so each request runs
+        // under state_mutex. The response is sent after the lock is released:
+        // a client that reads slowly only stalls itself.
+        std::ostringstream response;
+        response << std::setprecision(std::numeric_limits<double>::max_digits10);
+        try {
+            if (command == "BATCH") {
+                handle_batch(args, in, response);  // locks once its lines are read
+            } else {
+                std::lock_guard<std::mutex> lock(state_mutex);
+                if (command == "QUERY") {
+                    handle_query(args, response);
+                } else if (command == "SSSP") {
+                    handle_sssp(args, response);
+                } else if (command == "UPDATE") {
+                    handle_update(args, response);
+                } else if (command == "DELETE") {
+                    handle_delete(args, response);
+                } else if (command == "STATS") {
+                    response << "OK " << graph.node_count() << " " << graph.edge_count()
+                             << " " << num_partitions << " " << cache.size()
+                             << " " << cache.get_hits() << " " << cache.get_misses() << "\n";
+                } else {
+                    response << "ERR unknown command " << command << "\n";
+                }
+            }
+        } catch (const std::exception& e) {
+            response << "ERR " << e.what() << "\n";
+        }
+
+        // Stream each response back as soon as it is ready
+        out << response.str();
+        out.flush();
+    }
+    return true;
+}
+
+void QueryServer::handle_query(std::istream& args, std::ostream& out) {
+    int source, target;
+    size_t objective = 0;
+    if (!(args >> source >> target)) throw std::invalid_argument("usage: QUERY s t [obj]");
+    args >> objective;
+    check_node(source);
+    check_node(target);
+    check_objective(objective);
+
+    // Depots are queried over and over, so a miss builds and caches the
+    // whole tree instead of running a one-off point-to-point search
+    SSSPCache::TreePtr tree = cache.get(graph, source, objective);
+
+    out << "OK ";
+    write_distance(out, tree->get_distance(target));
+    for (int node : tree->get_path(target)) out << " " << node;
+    out << "\n";
+}
+
+void QueryServer::handle_sssp(std::istream& args, std::ostream& out) {
+    int source;
+    size_t objective = 0;
+    if (!(args >> source)) throw std::invalid_argument("usage: SSSP s [obj]");
+    args >> objective;
+    check_node(source);
+    check_objective(objective);
+
+    SSSPCache::TreePtr tree = cache.get(graph, source, objective);
+
+    out << "OK";
+    for (size_t node = 0; node < graph.node_count(); ++node) {
+        out << " ";
+        write_distance(out, tree->get_distance(node));
+    }
+    out << "\n";
+}
+
+void QueryServer::handle_batch(std::istream& args, std::istream& in, std::ostream& out) {
+    long count;
+    size_t objective = 0;
+    if (!(args >> count) || count < 0) throw std::invalid_argument("usage: BATCH k [obj]");
+    if (count > MAX_BATCH_QUERIES) {
+        throw std::invalid_argument("batch larger than " + std::to_string(MAX_BATCH_QUERIES) + " queries");
+    }
+    args >> objective;
+
+    // Read the whole batch first so it can be answered in parallel;
+    // malformed lines get their own ERR response in place. State grows
+    // with the lines actually read, not with the announced count.
+    std::vector<QueryPool::Query> queries;
+    std::vector<std::string> errors;
+    std::vector<long> slots;
+    std::string line;
+    while (static_cast<long>(errors.size()) < count && std::getline(in, line)) {
+        const long i = errors.size();
+        errors.emplace_back();
+        std::istringstream fields(line);
+        int source, target;
+        if (!(fields >> source >> target)) {
+            errors[i] = "malformed query";
+        } else if (source < 0 || source >= static_cast<int>(graph.node_count()) ||
+                   target < 0 || target >= static_cast<int>(graph.node_count())) {
+            errors[i] = "node out of range";
+        } else {
+            queries.push_back({source, target});
+            slots.push_back(i);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(state_mutex);
+    check_objective(objective);
+
+    std::vector<double> results = pool.distances(queries, objective);
+
+    // A stream that ends mid-batch only gets answers for the lines it sent
+    size_t next = 0;
+    for (long i = 0; i < static_cast<long>(errors.size()); ++i) {
+        if (next < slots.size() && slots[next] == i) {
+            out << "OK ";
+            write_distance(out, results[next++]);
+            out << "\n";
+        } else {
+            out << "ERR " << errors[i] << "\n";
+        }
+    }
+}
+
+void QueryServer::handle_update(std::istream& args, std::ostream& out) {
+    int src, tgt;
+    if (!(args >> src >> tgt)) throw std::invalid_argument("usage: UPDATE u v w1 [w2 ...]");
+    // A mistyped ID must not silently grow the graph
+    check_node(src);
+    check_node(tgt);
+
+    std::vector<double> weights;
+    double w;
+    while (args >> w) weights.push_back(w);
+    if (weights.empty()) throw std::invalid_argument("usage: UPDATE u v w1 [w2 ...]");
+    for (double weight : weights) {
+        if (weight < 0) throw std::invalid_argument("weights must be non-negative");
+    }
+
+    EdgeChange change{src, tgt, {}, weights};
+    if (const auto* edge = graph.find_edge(src, tgt)) change.old_weights = edge->weights;
+
+    graph.set_edge(src, tgt, weights);
+    num_objectives = std::min(num_objectives, weights.size());
+    cache.apply_changes(graph, {change});
+    out << "OK\n";
+}
+
+void QueryServer::handle_delete(std::istream& args, std::ostream& out) {
+    int src, tgt;
+    if (!(args >> src >> tgt)) throw std::invalid_argument("usage: DELETE u v");
+
+    const auto* edge = graph.find_edge(src, tgt);
+    if (edge) {
+        EdgeChange change{src, tgt, edge->weights, {}};
+        graph.remove_edge(src, tgt);
+        cache.apply_changes(graph, {change});
+    }
+    out << "OK\n";
+}
+
+void QueryServer::serve_unix_socket(const std::string& path) {
+    sockaddr_un addr{};
+    if (path.size() >= sizeof(addr.sun_path)) {
+        throw std::invalid_argument("Socket path too long: " + path);
+    }
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+    // Only a stale socket may be replaced; a mistyped path must not cost a file
+    struct stat info;
+    if (::lstat(path.c_str(), &info) == 0) {
+        if (!S_ISSOCK(info.st_mode)) {
+            throw std::runtime_error("Refusing to replace " + path + ": not a socket");
+        }
+        ::unlink(path.c_str());
+    }
+
+    int listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0) throw std::runtime_error(std::string("socket: ") + std::strerror(errno));
+
+    if (::bind(listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        ::listen(listen_fd, 16) < 0) {
+        std::string reason = std::strerror(errno);
+        ::close(listen_fd);
+        throw std::runtime_error("Could not listen on " + path + ": " + reason);
+    }
+
+    // One thread per connection, so an idle client never holds up the others
+    struct Session {
+        std::thread thread;
+        int fd;
+        bool done;
+    };
+    std::list<Session> sessions;
+    std::mutex sessions_mutex;
+    bool running = true;  // guarded by sessions_mutex
+
+    while (true) {
+        int fd = ::accept(listen_fd, nullptr, nullptr);
+        if (fd < 0 && errno == EINTR) continue;
+
+        std::lock_guard<std::mutex> lock(sessions_mutex);
+        if (fd < 0 || !running) {
+            if (fd >= 0) ::close(fd);
+            break;
+        }
+
+        // Reap sessions that have ended
+        for (auto it = sessions.begin(); it != sessions.end();) {
+            if (!it->done) {
+                ++it;
+                continue;
+            }
+            it->thread.join();
+            ::close(it->fd);
+            it = sessions.erase(it);
+        }
+
+        sessions.push_back({std::thread(), fd, false});
+        Session& session = sessions.back();
+        session.thread = std::thread([this, &session, &sessions, &sessions_mutex, &running, listen_fd] {
+            bool keep_running;
+            {
+                SocketStreamBuf buf(session.fd);
+                std::istream in(&buf);
+                std::ostream out(&buf);
+                keep_running = serve(in, out);
+            }
+
+            std::lock_guard<std::mutex> lock(sessions_mutex);
+            session.done = true;
+            if (!keep_running && running) {
+                // SHUTDOWN: wake accept() and end every other session
+                running = false;
+                ::shutdown(listen_fd, SHUT_RDWR);
+                for (auto& other : sessions) {
+                    if (&other != &session) ::shutdown(other.fd, SHUT_RDWR);
+                }
+            }
+        });
+    }
+
+    for (auto& session : sessions) {
+        session.thread.join();
+        ::close(session.fd);
+    }
+    ::close(listen_fd);
+    ::unlink(path.c_str());
+}
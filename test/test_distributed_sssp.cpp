@@ -0,0 +1,172 @@
+#include "../include/distributed_sssp.hpp"
+#include "../include/mpi_distributor.hpp"
+#include "../include/hybrid_engine.hpp"
+#include "../include/query_pool.hpp"
+#include <mpi.h>
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <limits>
+#include <cmath>
+
+// Same graph on every rank: mostly light edges plus a few heavy shortcuts,
+// and one node nobody can reach
+static DynamicGraph make_graph(int nodes) {
+    DynamicGraph graph;
+    std::mt19937 gen(31);
+    std::uniform_int_distribution<> node_dist(0, nodes - 2);
+    std::uniform_real_distribution<> light(0.5, 4.0);
+    std::uniform_real_distribution<> heavy(20.0, 200.0);
+    for (int i = 0; i < nodes * 4; ++i) {
+        graph.add_edge(node_dist(gen), node_dist(gen), {i % 10 == 0 ? heavy(gen) : light(gen)});
+    }
+    graph.add_node(nodes - 1);
+    return graph;
+}
+
+void test_delta_stepping(int rank, int size) {
+    const int NODES = 5000;
+    DynamicGraph graph = make_graph(NODES);
+
+    // Scattered ownership, so most edges cross ranks
+    std::vector<int> owner(NODES);
+    for (int v = 0; v < NODES; ++v) owner[v] = (v * 7919) % size;
+
+    QueryContext reference;
+    for (double delta : {0.0, 0.5, 1e9}) {
+        DistributedSSSP sssp(graph, owner, MPI_COMM_WORLD, delta);
+        for (int source : {0, 1, NODES / 2}) {
+            double start = MPI_Wtime();
+            sssp.compute(source);
+            double elapsed = MPI_Wtime() - start;
+
+            reference.run(graph, source);
+            for (int v = 0; v < NODES; ++v) {
+                if (owner[v] == rank) assert(sssp.get_distance(v) == reference.get_distance(v));
+            }
+
+            sssp.gather(0);
+            if (rank == 0) {
+                for (int v = 0; v < NODES; ++v) assert(sssp.get_distance(v) == reference.get_distance(v));
+                assert(sssp.get_path(NODES - 1).empty());
+
+                std::vector<int> path = sssp.get_path(NODES / 3);
+                assert(!path.empty() && path.front() == source && path.back() == NODES / 3);
+                double cost = 0;
+                for (size_t h = 0; h + 1 < path.size(); ++h) {
+                    double best = std::numeric_limits<double>::max();
+                    for (const auto& edge : graph.get_edges(path[h])) {
+                        if (edge.target == path[h + 1]) best = std::min(best, edge.weights[0]);
+                    }
+                    cost += best;
+                }
+                assert(std::abs(cost - reference.get_distance(NODES / 3)) < 1e-9);
+
+                if (source == 0) {
+                    std::cout << "  delta " << sssp.get_delta() << ": " << sssp.get_phase_count()
+                              << " phases, " << sssp.get_exchange_count() << " exchanges, "
+                              << elapsed * 1000 << " ms\n";
+                }
+            }
+        }
+    }
+    if (rank == 0) std::cout << "✅ Passed distributed delta-stepping test (" << size << " ranks)\n";
+}
+
+void test_distributor_partitions(int rank, int size) {
+    // Each rank only holds its partition from MPIDistributor
+    DynamicGraph graph(4);
+    graph.add_edge(0, 1, {4.0});
+    graph.add_edge(1, 0, {4.0});
+    graph.add_edge(0, 2, {2.0});
+    graph.add_edge(2, 0, {2.0});
+    graph.add_edge(1, 3, {5.0});
+    graph.add_edge(3, 1, {5.0});
+    graph.add_edge(2, 3, {1.0});
+    graph.add_edge(3, 2, {1.0});
+
+    MPIDistributor distributor(graph);
+    distributor.partition_and_distribute();
+    const std::vector<int>& owner = distributor.get_node_partitions();
+    assert(owner.size() == 4);
+
+    DistributedSSSP sssp(distributor.get_local_partition(), owner);
+    sssp.compute(1);
+    sssp.gather(0);
+    if (rank == 0) {
+        assert(sssp.get_distance(0) == 4.0);
+        assert(sssp.get_distance(2) == 6.0);
+        assert(sssp.get_distance(3) == 5.0);
+        std::cout << "✅ Passed distributed SSSP on distributor partitions (" << size << " ranks)\n";
+    }
+}
+
+void test_halo_overlap(int rank, int size) {
+    const int NODES = 5000;
+    DynamicGraph graph = make_graph(NODES);
+    QueryContext reference;
+    HybridEngine engine(graph);
+
+    int provided;
+    MPI_Query_thread(&provided);
+
+    // Master-only MPI and, when the library allows it, per-thread halo
+    // messages must give the same result
+    for (int mode = 0; mode < 4; ++mode) {
+        const bool multiple = mode >= 2, scattered = mode % 2;
+        std::vector<int> owner(NODES);
+        for (int v = 0; v < NODES; ++v) {
+            owner[v] = scattered ? (v * 7919) % size : std::min(size - 1, v * size / NODES);
+        }
+        engine.set_thread_multiple(multiple);
+
+        for (int source : {0, NODES / 2}) {
+            double start = MPI_Wtime();
+            engine.compute_distributed(source, owner);
+            double elapsed = MPI_Wtime() - start;
+            assert(engine.uses_thread_multiple() == (multiple && provided == MPI_THREAD_MULTIPLE));
+
+            reference.run(graph, source);
+            std::vector<double> local = engine.get_distances();
+            for (int v = 0; v < NODES; ++v) {
+                if (owner[v] != rank) continue;
+                assert(local[v] == reference.get_distance(v));
+                [[maybe_unused]] int pred = engine.get_predecessors()[v];
+                assert(v == source || local[v] == std::numeric_limits<double>::max() ||
+                       (pred >= 0 && graph.find_edge(pred, v)));
+            }
+
+            // Owned rows combine into the full distance vector
+            std::vector<double> all(NODES);
+            for (int v = 0; v < NODES; ++v) {
+                if (owner[v] != rank) local[v] = std::numeric_limits<double>::max();
+            }
+            MPI_Allreduce(local.data(), all.data(), NODES, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD);
+            for (int v = 0; v < NODES; ++v) assert(all[v] == reference.get_distance(v));
+
+            if (rank == 0 && source == 0) {
+                std::cout << "  " << (scattered ? "scattered" : "block") << " ownership"
+                          << (engine.uses_thread_multiple() ? ", per-thread MPI: " : ": ")
+                          << engine.get_distributed_iterations() << " halo iterations, "
+                          << elapsed * 1000 << " ms\n";
+            }
+        }
+    }
+    if (rank == 0) std::cout << "✅ Passed overlapped halo exchange test (" << size << " ranks)\n";
+}
+
+int main(int argc, char** argv) {
+    // MPI_THREAD_MULTIPLE if available; the halo test covers both modes
+    int provided;
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
+    int rank, size;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    test_delta_stepping(rank, size);
+    test_distributor_partitions(rank, size);
+    test_halo_overlap(rank, size);
+
+    MPI_Finalize();
+    return 0;
+}
@@ -17,6 +17,21 @@ void test_add_remove_edges() {
     std::cout << "✅ Passed add/remove edge tests\n";
 }
 
+void test_reversed_graph() {
+    DynamicGraph graph;
+    graph.add_edge(0, 1, {4.0, 10.0});
+    graph.add_edge(1, 2, {2.0, 15.0});
+    graph.add_node(3);
+
+    DynamicGraph rev = graph.reversed();
+    assert(rev.node_count() == 4);
+    assert(rev.edge_count() == 2);
+    assert(rev.find_edge(1, 0) && rev.find_edge(1, 0)->weights == std::vector<double>({4.0, 10.0}));
+    assert(rev.find_edge(2, 1) && !rev.find_edge(0, 1));
+
+    std::cout << "✅ Passed reversed graph test\n";
+}
+
 void test_metis_partitioning() {
     DynamicGraph graph;
     graph.add_edge(0, 1, {1.0, 1.0});
@@ -32,6 +47,7 @@ void test_metis_partitioning() {
 
 int main() {
     test_add_remove_edges();
+    test_reversed_graph();
     test_metis_partitioning();
     return 0;
 }
\ No newline at end of file
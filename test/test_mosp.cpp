@@ -1,37 +1,682 @@
+#include "../include/mosp_engine.hpp"
 #include "../include/graph.hpp"
-#include "../include/metis_utils.hpp"
+#include "../include/query_pool.hpp"
+#include "../include/boa_engine.hpp"
+#include "../include/pareto_queue_engine.hpp"
 #include <cassert>
 #include <iostream>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <algorithm>
 
-void test_add_remove_edges() {
-    DynamicGraph graph;
-    graph.add_edge(0, 1, {4.0, 10.0});
-    graph.add_edge(0, 2, {2.0, 15.0});
-    
-    assert(graph.node_count() == 3);
-    assert(graph.get_edges(0).size() == 2);
-    
-    graph.remove_edge(0, 1);
-    assert(graph.get_edges(0).size() == 1);
-    
-    std::cout << "✅ Passed add/remove edge tests\n";
-}
-
-void test_metis_partitioning() {
+// Two disjoint routes 0->4: via 2 (fast, expensive) and via 3 (slow, cheap),
+// sharing the first hop 0->1
+static DynamicGraph make_two_route_graph() {
     DynamicGraph graph;
     graph.add_edge(0, 1, {1.0, 1.0});
-    graph.add_edge(1, 2, {1.0, 1.0});
-    graph.add_edge(2, 0, {1.0, 1.0});
-    
-    MetisUtils::partition_graph(graph, 2);
-    auto parts = graph.get_partitions();
-    
-    assert(parts.size() == 3);
-    std::cout << "✅ Passed METIS partitioning test\n";
+    graph.add_edge(1, 2, {1.0, 5.0});
+    graph.add_edge(2, 4, {1.0, 5.0});
+    graph.add_edge(1, 3, {5.0, 1.0});
+    graph.add_edge(3, 4, {5.0, 1.0});
+    return graph;
+}
+
+void test_per_objective_sosp() {
+    DynamicGraph graph = make_two_route_graph();
+
+    SOSPEngine time_engine(graph, ObjectiveWeight{0});
+    SOSPEngine cost_engine(graph, ObjectiveWeight{1});
+    time_engine.compute(0);
+    cost_engine.compute(0);
+
+    assert(time_engine.get_distance(4) == 3.0);
+    assert(cost_engine.get_distance(4) == 3.0);
+    assert((time_engine.get_path(4) == std::vector<int>{0, 1, 2, 4}));
+    assert((cost_engine.get_path(4) == std::vector<int>{0, 1, 3, 4}));
+    std::cout << "✅ Passed per-objective SOSP test\n";
+}
+
+void test_ensemble_mosp() {
+    DynamicGraph graph = make_two_route_graph();
+    // Shortcut that no single-objective tree uses
+    graph.add_edge(0, 4, {10.0, 10.0});
+
+    MOSPEngine engine(graph, {0, 1});
+    PathResult result = engine.compute_ensemble(0, 4);
+
+    assert(result.nodes.size() == 4);
+    assert(result.nodes.front() == 0 && result.nodes.back() == 4);
+    assert(result.objectives.size() == 2);
+    assert(result.objectives[0] + result.objectives[1] == 14.0);
+
+    PathResult unreachable = engine.compute_ensemble(4, 0);
+    assert(unreachable.nodes.empty());
+    std::cout << "✅ Passed ensemble MOSP test\n";
+}
+
+void test_incremental_ensemble_update() {
+    DynamicGraph graph;
+    const int NODES = 1000;
+    std::mt19937 gen(3);
+    std::uniform_int_distribution<> node_dist(0, NODES-1);
+    std::uniform_real_distribution<> weight_dist(0.5, 5.0);
+    for (int i = 0; i < NODES * 5; ++i) {
+        graph.add_edge(node_dist(gen), node_dist(gen), {weight_dist(gen), weight_dist(gen)});
+    }
+
+    MOSPEngine engine(graph, {0, 1});
+    engine.compute_ensemble(0, NODES - 1);
+
+    for (int round = 0; round < 3; ++round) {
+        // About 1% of the edges change per round
+        std::vector<int> changed;
+        for (int i = 0; i < NODES / 20; ++i) {
+            int u = node_dist(gen);
+            const auto& edges = graph.get_edges(u);
+            if (!edges.empty() && i % 2 == 0) {
+                graph.set_edge(u, edges[0].target, {weight_dist(gen), weight_dist(gen)});
+            } else {
+                graph.add_edge(u, node_dist(gen), {weight_dist(gen), weight_dist(gen)});
+            }
+            changed.push_back(u);
+        }
+        engine.update(changed);
+
+        MOSPEngine fresh(graph, {0, 1});
+        fresh.compute_ensemble(0, NODES - 1);
+
+        // Same ensemble graph, so the same ensemble distances everywhere
+        QueryContext incremental_ctx, fresh_ctx;
+        incremental_ctx.run(engine.get_ensemble_graph(), 0);
+        fresh_ctx.run(fresh.get_ensemble_graph(), 0);
+        for (int node = 0; node < NODES; ++node) {
+            assert(incremental_ctx.get_distance(node) == fresh_ctx.get_distance(node));
+        }
+        assert(engine.get_ensemble_path(NODES - 1).nodes.size() ==
+               fresh.get_ensemble_path(NODES - 1).nodes.size());
+    }
+    std::cout << "✅ Passed incremental ensemble update test\n";
+}
+
+// Random DAG (edges only from lower to higher IDs), so exhaustive path
+// enumeration terminates and serves as a reference
+static DynamicGraph make_random_dag(int nodes, int edges, size_t objectives, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> node_dist(0, nodes - 1);
+    std::uniform_int_distribution<> weight_dist(1, 9);
+    DynamicGraph graph(nodes);
+    for (int i = 0; i < edges; ++i) {
+        int u = node_dist(gen), v = node_dist(gen);
+        if (u == v) continue;
+        std::vector<double> w(objectives);
+        for (auto& x : w) x = weight_dist(gen);
+        graph.set_edge(std::min(u, v), std::max(u, v), w);
+    }
+    return graph;
+}
+
+// Every source -> target path of a DAG, filtered to its Pareto front
+static void enumerate_paths(const DynamicGraph& graph, int u, int target, std::vector<int>& nodes,
+                            std::vector<double>& objs, std::vector<PathResult>& paths) {
+    if (u == target) {
+        paths.push_back({nodes, objs});
+        return;
+    }
+    for (const auto& edge : graph.get_edges(u)) {
+        nodes.push_back(edge.target);
+        for (size_t i = 0; i < objs.size(); ++i) objs[i] += edge.weights[i];
+        enumerate_paths(graph, edge.target, target, nodes, objs, paths);
+        for (size_t i = 0; i < objs.size(); ++i) objs[i] -= edge.weights[i];
+        nodes.pop_back();
+    }
+}
+
+[[maybe_unused]] static std::vector<PathResult> brute_force_front(const DynamicGraph& graph, int source, int target, size_t k) {
+    std::vector<PathResult> paths;
+    std::vector<int> nodes{source};
+    std::vector<double> objs(k, 0.0);
+    enumerate_paths(graph, source, target, nodes, objs, paths);
+    Pareto::filter_dominated(paths);
+    return paths;
+}
+
+static std::vector<std::vector<double>> objective_set(const std::vector<PathResult>& front) {
+    std::vector<std::vector<double>> objs;
+    for (const auto& path : front) objs.push_back(path.objectives);
+    std::sort(objs.begin(), objs.end());
+    objs.erase(std::unique(objs.begin(), objs.end()), objs.end());
+    return objs;
+}
+
+// Objectives of a node sequence recomputed from the graph
+[[maybe_unused]] static std::vector<double> path_cost(const DynamicGraph& graph, const std::vector<int>& nodes, size_t k) {
+    std::vector<double> cost(k, 0.0);
+    for (size_t h = 0; h + 1 < nodes.size(); ++h) {
+        const auto* edge = graph.find_edge(nodes[h], nodes[h + 1]);
+        assert(edge);
+        for (size_t i = 0; i < k; ++i) cost[i] += edge->weights[i];
+    }
+    return cost;
+}
+
+void test_label_setting() {
+    for (unsigned seed = 0; seed < 10; ++seed) {
+        DynamicGraph graph = make_random_dag(14, 60, 3, seed);
+        MOSPEngine engine(graph, {0, 1, 2});
+
+        auto exact = engine.compute_pareto(0, 13);
+        assert(objective_set(exact) == objective_set(brute_force_front(graph, 0, 13, 3)));
+        for ([[maybe_unused]] const auto& path : exact) {
+            assert(path.nodes.front() == 0 && path.nodes.back() == 13);
+            assert(path_cost(graph, path.nodes, 3) == path.objectives);
+        }
+    }
+
+    // Cycles are fine for label-setting
+    DynamicGraph cyclic = make_two_route_graph();
+    cyclic.add_edge(4, 0, {1.0, 1.0});
+    MOSPEngine engine(cyclic, {0, 1});
+    auto front = engine.compute_label_setting(0, 4);
+    assert(front.size() == 2);
+    assert((front[0].nodes == std::vector<int>{0, 1, 2, 4}));
+    assert((front[1].nodes == std::vector<int>{0, 1, 3, 4}));
+    assert(engine.compute_label_setting(4, 5).empty());
+    std::cout << "✅ Passed label-setting MOSP test\n";
+}
+
+void test_epsilon_label_setting() {
+    // Grid with anti-correlated objectives: large exact fronts
+    const int SIDE = 8;
+    std::mt19937 gen(21);
+    std::uniform_real_distribution<> unit(1.0, 10.0);
+    DynamicGraph graph(SIDE * SIDE);
+    for (int r = 0; r < SIDE; ++r) {
+        for (int c = 0; c < SIDE; ++c) {
+            int u = r * SIDE + c;
+            for (int v : {c + 1 < SIDE ? u + 1 : -1, r + 1 < SIDE ? u + SIDE : -1}) {
+                if (v < 0) continue;
+                double t = unit(gen);
+                graph.add_edge(u, v, {t, 11.0 - t, unit(gen)});
+            }
+        }
+    }
+    const int target = SIDE * SIDE - 1;
+    const int hops = 2 * (SIDE - 1);
+
+    MOSPEngine engine(graph, {0, 1, 2});
+    auto exact = engine.compute_label_setting(0, target);
+    size_t exact_labels = engine.get_label_count();
+
+    // A repeated query reuses the arena chunks instead of allocating more
+    [[maybe_unused]] size_t chunks = engine.get_arena_chunks();
+    assert(chunks > 1);
+    assert(objective_set(engine.compute_label_setting(0, target)) == objective_set(exact));
+    assert(engine.get_arena_chunks() == chunks);
+
+    for (double epsilon : {0.01, 0.1}) {
+        auto approx = engine.compute_label_setting(0, target, epsilon);
+        assert(!approx.empty() && approx.size() <= exact.size());
+        assert(engine.get_label_count() <= exact_labels);
+
+        for ([[maybe_unused]] const auto& path : approx) {
+            assert(path_cost(graph, path.nodes, 3) == path.objectives);
+        }
+        // Every exact point is covered within (1 + eps)^hops
+        double factor = std::pow(1.0 + epsilon, hops);
+        for (const auto& path : exact) {
+            [[maybe_unused]] bool covered = std::any_of(approx.begin(), approx.end(), [&](const PathResult& a) {
+                for (size_t i = 0; i < 3; ++i) {
+                    if (a.objectives[i] > path.objectives[i] * factor) return false;
+                }
+                return true;
+            });
+            assert(covered);
+        }
+        if (epsilon == 0.1) {
+            std::cout << "✅ Passed epsilon label-setting test (" << exact.size() << " exact, "
+                      << approx.size() << " approximate paths, " << exact_labels << " -> "
+                      << engine.get_label_count() << " labels)\n";
+        }
+    }
+
+    [[maybe_unused]] bool threw = false;
+    try {
+        engine.compute_label_setting(0, target, -1.0);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+}
+
+// Random sparse digraph with cycles and correlated (time, cost) weights
+static DynamicGraph make_random_graph(int nodes, int edges, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> node_dist(0, nodes - 1);
+    std::uniform_real_distribution<> weight_dist(1.0, 10.0);
+    DynamicGraph graph(nodes);
+    for (int i = 0; i < edges; ++i) {
+        int u = node_dist(gen), v = node_dist(gen);
+        if (u == v) continue;
+        double t = weight_dist(gen);
+        graph.set_edge(u, v, {t, std::round(11.0 - t + weight_dist(gen))});
+    }
+    return graph;
+}
+
+void test_boa_star() {
+    for (unsigned seed = 0; seed < 20; ++seed) {
+        DynamicGraph graph = make_random_graph(60, 240, seed);
+        MOSPEngine generic(graph, {0, 1});
+        BOAEngine boa(graph);
+
+        for (int target : {59, 17, 3}) {
+            auto expected = generic.compute_pareto(0, target);
+            auto front = boa.compute_pareto(0, target);
+            assert(objective_set(front) == objective_set(expected));
+            for (size_t i = 0; i < front.size(); ++i) {
+                assert(front[i].nodes.front() == 0 && front[i].nodes.back() == target);
+                assert(path_cost(graph, front[i].nodes, 2) == front[i].objectives);
+                if (i > 0) assert(front[i - 1].objectives[1] > front[i].objectives[1]);
+            }
+        }
+    }
+
+    // Swapped objective indices give the mirrored front
+    DynamicGraph routes = make_two_route_graph();
+    BOAEngine swapped(routes, 1, 0);
+    auto front = swapped.compute_pareto(0, 4);
+    assert(front.size() == 2 && (front[0].nodes == std::vector<int>{0, 1, 3, 4}));
+    assert(BOAEngine(routes).compute_pareto(4, 0).empty());
+
+    // Road-like grid with anti-correlated weights: BOA* against the generic
+    // label-setting engine on a few hundred Pareto paths
+    const int SIDE = 30;
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<> unit(1.0, 10.0);
+    DynamicGraph graph(SIDE * SIDE);
+    for (int u = 0; u < SIDE * SIDE; ++u) {
+        for (int v : {u % SIDE + 1 < SIDE ? u + 1 : -1, u + SIDE < SIDE * SIDE ? u + SIDE : -1}) {
+            if (v < 0) continue;
+            for (auto [a, b] : {std::pair<int, int>{u, v}, {v, u}}) {
+                double t = unit(gen);
+                graph.add_edge(a, b, {t, std::round(11.0 - t + unit(gen))});
+            }
+        }
+    }
+    MOSPEngine generic(graph, {0, 1});
+    BOAEngine boa(graph);
+    auto t0 = std::chrono::high_resolution_clock::now();
+    auto expected = generic.compute_pareto(0, SIDE * SIDE - 1);
+    auto t1 = std::chrono::high_resolution_clock::now();
+    auto result = boa.compute_pareto(0, SIDE * SIDE - 1);
+    auto t2 = std::chrono::high_resolution_clock::now();
+    assert(objective_set(result) == objective_set(expected));
+
+    std::cout << "✅ Passed BOA* test (" << result.size() << " paths, label-setting "
+              << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms, BOA* "
+              << std::chrono::duration<double, std::milli>(t2 - t1).count() << " ms)\n";
+}
+
+void test_pareto_queue_engine() {
+    for (unsigned seed = 0; seed < 10; ++seed) {
+        DynamicGraph graph = make_random_dag(40, 200, 3, seed);
+        graph.add_edge(39, 0, {1.0, 1.0, 1.0});  // one cycle
+        MOSPEngine sequential(graph, {0, 1, 2});
+
+        for (int threads : {1, 4}) {
+            ParetoQueueEngine parallel(graph, {0, 1, 2}, threads);
+            for (int target : {39, 20}) {
+                auto expected = sequential.compute_pareto(0, target);
+                auto front = parallel.compute_pareto(0, target);
+                assert(objective_set(front) == objective_set(expected));
+                assert(front.size() == objective_set(front).size());
+                for (size_t i = 0; i < front.size(); ++i) {
+                    assert(path_cost(graph, front[i].nodes, 3) == front[i].objectives);
+                    if (i > 0) assert(front[i - 1].objectives < front[i].objectives);
+                }
+            }
+        }
+    }
+
+    // Anti-correlated grid: many labels per round
+    const int SIDE = 8;
+    std::mt19937 gen(21);
+    std::uniform_real_distribution<> unit(1.0, 10.0);
+    DynamicGraph grid(SIDE * SIDE);
+    for (int u = 0; u < SIDE * SIDE; ++u) {
+        for (int v : {u % SIDE + 1 < SIDE ? u + 1 : -1, u + SIDE < SIDE * SIDE ? u + SIDE : -1}) {
+            if (v < 0) continue;
+            double t = unit(gen);
+            grid.add_edge(u, v, {t, 11.0 - t, unit(gen)});
+        }
+    }
+    MOSPEngine sequential(grid, {0, 1, 2});
+    ParetoQueueEngine parallel(grid, {0, 1, 2}, 4);
+    auto expected = sequential.compute_pareto(0, SIDE * SIDE - 1);
+    auto front = parallel.compute_pareto(0, SIDE * SIDE - 1);
+    assert(objective_set(front) == objective_set(expected));
+    assert(parallel.get_round_count() < parallel.get_label_count());
+
+    std::cout << "✅ Passed Pareto-queue MOSP test (" << front.size() << " paths, "
+              << parallel.get_label_count() << " labels in " << parallel.get_round_count()
+              << " rounds)\n";
+}
+
+void test_constrained_query() {
+    const double INF = std::numeric_limits<double>::infinity();
+    std::mt19937 gen(8);
+    for (unsigned seed = 0; seed < 10; ++seed) {
+        DynamicGraph graph = make_random_dag(40, 200, 3, seed);
+        graph.add_edge(39, 0, {1.0, 1.0, 1.0});
+        MOSPEngine engine(graph, {0, 1, 2});
+        auto front = engine.compute_pareto(0, 39);
+        if (front.empty()) continue;
+
+        for (int trial = 0; trial < 10; ++trial) {
+            size_t primary = trial % 3;
+            // Bounds around the front's range, sometimes infeasible
+            std::vector<double> bounds(3, INF);
+            for (size_t i = 0; i < 3; ++i) {
+                if (i == primary || trial % 4 == 0) continue;
+                std::uniform_real_distribution<> pick(front.back().objectives[i] * 0.5, 40.0);
+                bounds[i] = std::round(pick(gen));
+            }
+
+            // Reference: filter the full front
+            double best = INF;
+            for (const auto& path : front) {
+                bool ok = true;
+                for (size_t i = 0; i < 3; ++i) ok &= i == primary || path.objectives[i] <= bounds[i];
+                if (ok) best = std::min(best, path.objectives[primary]);
+            }
+
+            PathResult result = engine.compute_constrained(0, 39, primary, bounds);
+            if (best == INF) {
+                assert(result.nodes.empty());
+                continue;
+            }
+            assert(result.objectives[primary] == best);
+            assert(path_cost(graph, result.nodes, 3) == result.objectives);
+            for (size_t i = 0; i < 3; ++i) assert(i == primary || result.objectives[i] <= bounds[i]);
+        }
+    }
+
+    // Cheapest route under a time budget on the two-route graph
+    DynamicGraph routes = make_two_route_graph();
+    MOSPEngine engine(routes, {0, 1});
+    assert((engine.compute_constrained(0, 4, 1, {INF, INF}).nodes == std::vector<int>{0, 1, 3, 4}));
+    assert((engine.compute_constrained(0, 4, 1, {5.0, INF}).nodes == std::vector<int>{0, 1, 2, 4}));
+    assert(engine.compute_constrained(0, 4, 1, {2.0, INF}).nodes.empty());
+
+    // Cached bounds follow graph changes and target switches
+    routes.set_edge(3, 4, {1.0, 1.0});
+    assert((engine.compute_constrained(0, 4, 1, {2.0, INF}).nodes.empty()));
+    assert((engine.compute_constrained(0, 4, 1, {7.0, INF}).nodes == std::vector<int>{0, 1, 3, 4}));
+    assert((engine.compute_constrained(0, 3, 0, {INF, INF}).nodes == std::vector<int>{0, 1, 3}));
+    routes.remove_edge(1, 3);
+    assert((engine.compute_constrained(0, 4, 1, {INF, INF}).nodes == std::vector<int>{0, 1, 2, 4}));
+    assert(engine.compute_constrained(0, 3, 0, {INF, INF}).nodes.empty());
+
+    [[maybe_unused]] bool threw = false;
+    try {
+        engine.compute_constrained(0, 4, 2, {INF, INF});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "✅ Passed constrained shortest path test\n";
+}
+
+void test_weighted_sum_sweep() {
+    std::vector<std::vector<double>> preferences;
+    for (int l = 0; l <= 20; ++l) {
+        double a = l / 20.0;
+        preferences.push_back({a, 1.0 - a, l % 3 == 0 ? 0.5 : 0.0});
+    }
+
+    for (unsigned seed = 0; seed < 5; ++seed) {
+        DynamicGraph graph = make_random_graph(300, 1500, seed);
+        // Third objective on top of the (time, cost) weights
+        DynamicGraph three(graph.node_count());
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<> extra(0.0, 5.0);
+        for (int u = 0; u < static_cast<int>(graph.node_count()); ++u) {
+            for (const auto& edge : graph.get_edges(u)) {
+                three.add_edge(u, edge.target, {edge.weights[0], edge.weights[1], extra(gen)});
+            }
+        }
+
+        MOSPEngine engine(three, {0, 1, 2});
+        auto results = engine.compute_weighted_sums(0, 299, preferences);
+        assert(results.size() == preferences.size());
+
+        // Reference: one Dijkstra per preference on a re-weighted copy
+        QueryContext ctx;
+        for (size_t l = 0; l < preferences.size(); ++l) {
+            DynamicGraph scalar(three.node_count());
+            for (int u = 0; u < static_cast<int>(three.node_count()); ++u) {
+                for (const auto& edge : three.get_edges(u)) {
+                    double w = 0.0;
+                    for (size_t i = 0; i < 3; ++i) w += preferences[l][i] * edge.weights[i];
+                    scalar.add_edge(u, edge.target, {w});
+                }
+            }
+            double expected = ctx.run(scalar, 0, 299);
+            if (expected == std::numeric_limits<double>::max()) {
+                assert(results[l].nodes.empty());
+                continue;
+            }
+            double achieved = 0.0;
+            for (size_t i = 0; i < 3; ++i) achieved += preferences[l][i] * results[l].objectives[i];
+            assert(std::abs(achieved - expected) < 1e-9 * (1.0 + expected));
+            assert(path_cost(three, results[l].nodes, 3) == results[l].objectives);
+        }
+
+        // Strictly positive weights give supported points of the exact front
+        auto front = objective_set(engine.compute_pareto(0, 299));
+        for (size_t l = 1; l + 1 < preferences.size(); ++l) {
+            if (preferences[l][2] == 0.0 || results[l].nodes.empty()) continue;
+            assert(std::binary_search(front.begin(), front.end(), results[l].objectives));
+        }
+    }
+
+    DynamicGraph routes = make_two_route_graph();
+    MOSPEngine engine(routes, {0, 1});
+    auto ends = engine.compute_weighted_sums(0, 4, {{1.0, 0.0}, {0.0, 1.0}});
+    assert((ends[0].nodes == std::vector<int>{0, 1, 2, 4}));
+    assert((ends[1].nodes == std::vector<int>{0, 1, 3, 4}));
+    assert(engine.compute_weighted_sums(4, 0, {{1.0, 1.0}})[0].nodes.empty());
+    std::cout << "✅ Passed weighted-sum sweep test\n";
+}
+
+void test_streaming_pareto() {
+    // Anti-correlated grid with a few thousand Pareto paths
+    const int SIDE = 8;
+    std::mt19937 gen(21);
+    std::uniform_real_distribution<> unit(1.0, 10.0);
+    DynamicGraph grid(SIDE * SIDE);
+    for (int u = 0; u < SIDE * SIDE; ++u) {
+        for (int v : {u % SIDE + 1 < SIDE ? u + 1 : -1, u + SIDE < SIDE * SIDE ? u + SIDE : -1}) {
+            if (v < 0) continue;
+            double t = unit(gen);
+            grid.add_edge(u, v, {t, 11.0 - t, unit(gen)});
+        }
+    }
+    const int target = SIDE * SIDE - 1;
+    MOSPEngine engine(grid, {0, 1, 2});
+    auto exact = engine.compute_pareto(0, target);
+
+    // Everything is streamed, in lexicographic order, identical to the batch result
+    std::vector<PathResult> streamed;
+    [[maybe_unused]] bool complete = engine.stream_pareto(0, target, [&](const PathResult& path) {
+        streamed.push_back(path);
+        return true;
+    });
+    assert(complete && streamed.size() == exact.size());
+    for (size_t i = 0; i < exact.size(); ++i) {
+        assert(streamed[i].nodes == exact[i].nodes && streamed[i].objectives == exact[i].objectives);
+        if (i > 0) assert(streamed[i - 1].objectives < streamed[i].objectives);
+    }
+
+    // The callback can stop after the first few routes
+    size_t seen = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    complete = engine.stream_pareto(0, target, [&]([[maybe_unused]] const PathResult& path) {
+        assert(path.objectives == exact[seen].objectives);
+        return ++seen < 3;
+    });
+    auto first_routes = std::chrono::high_resolution_clock::now() - start;
+    assert(!complete && seen == 3);
+
+    // An expired deadline returns what is known: settled paths are exact,
+    // tentative ones are real paths no settled path dominates
+    bool done = true;
+    auto partial = engine.compute_pareto_until(0, target, MOSPEngine::Clock::now(), &done);
+    assert(!done);
+    for (size_t i = 0; i < partial.size(); ++i) {
+        assert(path_cost(grid, partial[i].nodes, 3) == partial[i].objectives);
+        assert(partial[i].nodes.back() == target);
+    }
+    done = false;
+    auto full = engine.compute_pareto_until(0, target, MOSPEngine::Clock::now() + std::chrono::hours(1), &done);
+    assert(done && objective_set(full) == objective_set(exact));
+
+    std::cout << "✅ Passed streaming Pareto test (first 3 of " << exact.size() << " paths after "
+              << std::chrono::duration<double, std::milli>(first_routes).count() << " ms)\n";
+}
+
+// Plain per-element reference, independent of the SIMD kernels
+static bool scalar_dominates(const double* a, const double* b, size_t k) {
+    bool better = false;
+    for (size_t i = 0; i < k; ++i) {
+        if (a[i] > b[i]) return false;
+        if (a[i] < b[i]) better = true;
+    }
+    return better;
+}
+
+// Reference: keep what no other vector dominates
+static std::vector<std::vector<double>> naive_front(const std::vector<std::vector<double>>& points) {
+    std::vector<std::vector<double>> front;
+    for (size_t i = 0; i < points.size(); ++i) {
+        bool dominated = false;
+        for (size_t j = 0; j < points.size() && !dominated; ++j) {
+            dominated = j != i && scalar_dominates(points[j].data(), points[i].data(), points[i].size());
+        }
+        if (!dominated) front.push_back(points[i]);
+    }
+    return front;
+}
+
+void test_dominance_kernel() {
+    std::mt19937 gen(9);
+    std::uniform_int_distribution<> value(0, 3);  // plenty of ties
+    for (size_t k : {1, 2, 3, 4, 5, 8}) {
+        for (int trial = 0; trial < 200; ++trial) {
+            // Odd block sizes exercise the paired K = 2 loop and its tail
+            size_t count = trial % 7;
+            std::vector<double> block(count * k), candidate(k);
+            for (auto& v : block) v = value(gen);
+            for (auto& v : candidate) v = value(gen);
+
+            bool expected = false;
+            for (size_t i = 0; i < count; ++i) {
+                bool single = scalar_dominates(&block[i * k], candidate.data(), k);
+                assert(Pareto::simd::dominates(&block[i * k], candidate.data(), k) == single);
+                expected |= single;
+            }
+            assert(Pareto::simd::dominated_by_any(block.data(), count, candidate.data(), k) == expected);
+        }
+    }
+    std::cout << "✅ Passed dominance kernel test"
+#if defined(__AVX2__)
+              << " (AVX2)"
+#endif
+              << "\n";
+}
+
+void test_pareto_filter() {
+    std::mt19937 gen(5);
+    for (size_t k = 1; k <= 5; ++k) {
+        for (int trial = 0; trial < 20; ++trial) {
+            // Small integer range forces ties and exact duplicates
+            std::uniform_int_distribution<> value(0, trial % 2 ? 6 : 1000);
+            std::vector<std::vector<double>> points(300, std::vector<double>(k));
+            for (auto& p : points) {
+                for (auto& v : p) v = value(gen);
+            }
+
+            auto expected = naive_front(points);
+            Pareto::filter_dominated(points);
+            assert(points == expected);  // same survivors, same order
+        }
+    }
+
+    // Both sums round to 1e20; the dominated point comes first in the input
+    std::vector<std::vector<double>> rounded = {{1e20, 2, 0, 0}, {1e20, 1, 0, 0}};
+    Pareto::filter_dominated(rounded);
+    assert((rounded == std::vector<std::vector<double>>{{1e20, 1, 0, 0}}));
+
+    // Large anti-correlated 2-D front
+    std::uniform_real_distribution<> unit(0.0, 1.0);
+    std::vector<PathResult> candidates(100000);
+    for (auto& c : candidates) {
+        double t = unit(gen);
+        c.objectives = {t, 1.0 - t + unit(gen) * 0.01};
+    }
+    auto start = std::chrono::high_resolution_clock::now();
+    Pareto::filter_dominated(candidates);
+    auto end = std::chrono::high_resolution_clock::now();
+    assert(!candidates.empty());
+    for (size_t i = 1; i < candidates.size(); ++i) {
+        assert(!Pareto::dominates(candidates[i-1].objectives, candidates[i].objectives));
+    }
+
+    std::cout << "✅ Passed Pareto filter test (10^5 candidates in "
+              << std::chrono::duration<double, std::milli>(end - start).count() << " ms)\n";
+}
+
+void test_merge_fronts() {
+    std::mt19937 gen(13);
+    std::uniform_int_distribution<> value(0, 30);
+    for (size_t parts : {1, 2, 5, 8, 13}) {
+        std::vector<std::vector<PathResult>> fronts(parts);
+        std::vector<PathResult> all;
+        for (auto& front : fronts) {
+            front.resize(value(gen));
+            for (auto& path : front) {
+                path.objectives = {double(value(gen)), double(value(gen)), double(value(gen))};
+                path.nodes = {value(gen)};
+            }
+            all.insert(all.end(), front.begin(), front.end());
+        }
+        Pareto::filter_dominated(all);
+
+        auto merged = Pareto::merge_fronts(fronts);
+        assert(merged.size() == all.size());
+        for (size_t i = 0; i < all.size(); ++i) {
+            assert(merged[i].objectives == all[i].objectives && merged[i].nodes == all[i].nodes);
+        }
+    }
+    assert(Pareto::merge_fronts(std::vector<std::vector<PathResult>>{}).empty());
+    std::cout << "✅ Passed parallel front merge test\n";
 }
 
 int main() {
-    test_add_remove_edges();
-    test_metis_partitioning();
+    test_per_objective_sosp();
+    test_ensemble_mosp();
+    test_incremental_ensemble_update();
+    test_label_setting();
+    test_epsilon_label_setting();
+    test_boa_star();
+    test_pareto_queue_engine();
+    test_constrained_query();
+    test_weighted_sum_sweep();
+    test_streaming_pareto();
+    test_dominance_kernel();
+    test_pareto_filter();
+    test_merge_fronts();
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,83 @@
+#include "../include/pareto_mpi.hpp"
+#include "../include/pareto_utils.hpp"
+#include <mpi.h>
+#include <cassert>
+#include <iostream>
+#include <random>
+
+// Deterministic partial front of `rank`, so every rank can build the
+// expected result locally
+static std::vector<PathResult> make_front(int rank, size_t k) {
+    std::mt19937 gen(100 + rank);
+    std::uniform_int_distribution<> value(0, 20);
+    std::uniform_int_distribution<> length(1, 6);
+
+    std::vector<PathResult> front(20 + rank * 7);
+    for (auto& path : front) {
+        path.objectives.resize(k);
+        for (auto& v : path.objectives) v = value(gen);
+        path.nodes.resize(length(gen));
+        for (auto& n : path.nodes) n = value(gen) + rank * 1000;
+    }
+    return front;
+}
+
+[[maybe_unused]] static bool same_front(const std::vector<PathResult>& a, const std::vector<PathResult>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].nodes != b[i].nodes || a[i].objectives != b[i].objectives) return false;
+    }
+    return true;
+}
+
+void test_serialization(int rank) {
+    auto front = make_front(rank, 3);
+    front.push_back(PathResult{});  // empty path survives the round trip
+    auto buffer = Pareto::serialize_front(front);
+    assert(same_front(Pareto::deserialize_front(buffer.data()), front));
+    if (rank == 0) std::cout << "✅ Passed front serialization test\n";
+}
+
+void test_front_reduction(int rank, int size) {
+    for (size_t k : {2, 3, 4}) {
+        std::vector<PathResult> expected;
+        for (int r = 0; r < size; ++r) {
+            auto part = make_front(r, k);
+            expected.insert(expected.end(), part.begin(), part.end());
+        }
+        Pareto::filter_dominated(expected);
+
+        auto reduced = Pareto::reduce_front(make_front(rank, k), 0);
+        if (rank == 0) {
+            assert(same_front(reduced, expected));
+        } else {
+            assert(reduced.empty());
+        }
+
+        auto everywhere = Pareto::allreduce_front(make_front(rank, k));
+        assert(same_front(everywhere, expected));
+    }
+
+    // Ranks without any path contribute nothing
+    std::vector<PathResult> local;
+    if (rank == size - 1) local = make_front(rank, 2);
+    auto merged = Pareto::allreduce_front(local);
+    Pareto::filter_dominated(local);
+    if (rank == size - 1) assert(same_front(merged, local));
+    assert(!merged.empty());
+
+    if (rank == 0) std::cout << "✅ Passed MPI front reduction test (" << size << " ranks)\n";
+}
+
+int main(int argc, char** argv) {
+    MPI_Init(&argc, &argv);
+    int rank, size;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    test_serialization(rank);
+    test_front_reduction(rank, size);
+
+    MPI_Finalize();
+    return 0;
+}
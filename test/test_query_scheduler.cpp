@@ -0,0 +1,63 @@
+#include "../include/query_scheduler.hpp"
+#include <mpi.h>
+#include <cassert>
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <thread>
+
+void test_work_stealing(int rank, int size) {
+    const int TASKS = 120;
+
+    // Task IDs differ from their indices so a wrong lookup shows up
+    std::vector<int> tasks(TASKS);
+    for (int i = 0; i < TASKS; ++i) tasks[i] = TASKS - 1 - i;
+
+    for (int chunk : {1, 4}) {
+        WorkStealingScheduler scheduler(MPI_COMM_WORLD, chunk);
+
+        // Skewed work: rank 0's home block holds all the slow tasks, so the
+        // other ranks run out early and must steal from it
+        std::vector<int> executions(TASKS, 0);
+        size_t executed = scheduler.run(tasks, [&](int task) {
+            const int index = TASKS - 1 - task;
+            if (index < TASKS / size) std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            ++executions[task];
+        });
+
+        std::vector<int> total(TASKS, 0);
+        MPI_Allreduce(executions.data(), total.data(), TASKS, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+        for (int t = 0; t < TASKS; ++t) assert(total[t] == 1);
+
+        long long local[2] = {static_cast<long long>(executed),
+                              static_cast<long long>(scheduler.get_stolen_count())};
+        long long sums[2], max_stolen;
+        MPI_Allreduce(local, sums, 2, MPI_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+        MPI_Allreduce(&local[1], &max_stolen, 1, MPI_LONG_LONG, MPI_MAX, MPI_COMM_WORLD);
+        assert(sums[0] == TASKS);
+        assert(size == 1 ? max_stolen == 0 : max_stolen > 0);
+
+        if (rank == 0) {
+            std::cout << "  chunk " << chunk << ": " << sums[1] << " of " << TASKS << " tasks stolen\n";
+        }
+    }
+
+    // An empty batch is a no-op on every rank
+    WorkStealingScheduler scheduler;
+    assert(scheduler.run({}, [](int) { assert(false); }) == 0);
+    assert(scheduler.get_stolen_count() == 0);
+
+    if (rank == 0) std::cout << "✅ Passed work-stealing scheduler test (" << size << " ranks)\n";
+}
+
+int main(int argc, char** argv) {
+    MPI_Init(&argc, &argv);
+    int rank, size;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    test_work_stealing(rank, size);
+
+    MPI_Finalize();
+    return 0;
+}
@@ -0,0 +1,199 @@
+#include "../include/query_server.hpp"
+#include "../include/graph.hpp"
+#include <cassert>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <fstream>
+#include <thread>
+#include <chrono>
+#include <cstring>
+#include <cstdio>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+static std::vector<std::string> run_session(QueryServer& server, const std::string& requests) {
+    std::istringstream in(requests);
+    std::ostringstream out;
+    server.serve(in, out);
+
+    std::vector<std::string> lines;
+    std::istringstream responses(out.str());
+    std::string line;
+    while (std::getline(responses, line)) lines.push_back(line);
+    return lines;
+}
+
+static DynamicGraph make_graph() {
+    DynamicGraph graph;
+    graph.add_edge(0, 1, {4.0, 1.0});
+    graph.add_edge(0, 2, {2.0, 8.0});
+    graph.add_edge(2, 3, {1.0, 1.0});
+    graph.add_edge(1, 3, {5.0, 1.0});
+    return graph;
+}
+
+void test_queries() {
+    QueryServer server(make_graph(), 1, 2);
+    auto lines = run_session(server,
+        "QUERY 0 3\n"
+        "QUERY 0 3 1\n"
+        "QUERY 3 0\n"
+        "SSSP 0\n"
+        "STATS\n");
+
+    assert(lines.size() == 5);
+    assert(lines[0] == "OK 3 0 2 3");
+    assert(lines[1] == "OK 2 0 1 3");
+    assert(lines[2] == "OK INF");
+    assert(lines[3] == "OK 0 4 2 3");
+    // Three trees built by the QUERYs, and SSSP 0 reuses the first
+    assert(lines[4] == "OK 4 4 1 3 1 3");
+    std::cout << "✅ Passed server query test\n";
+}
+
+void test_repeated_queries() {
+    QueryServer server(make_graph(), 1, 2);
+    auto lines = run_session(server,
+        "QUERY 0 3\n"
+        "QUERY 0 3\n"
+        "QUERY 0 1\n"
+        "STATS\n");
+
+    // Only the first query on a source computes anything
+    assert(lines.size() == 4);
+    assert(lines[0] == "OK 3 0 2 3");
+    assert(lines[1] == "OK 3 0 2 3");
+    assert(lines[2] == "OK 4 0 1");
+    assert(lines[3] == "OK 4 4 1 1 2 1");
+    std::cout << "✅ Passed server repeated query test\n";
+}
+
+void test_batch_and_updates() {
+    QueryServer server(make_graph(), 1, 2);
+    auto lines = run_session(server,
+        "BATCH 3\n"
+        "0 3\n"
+        "0 9\n"
+        "1 3\n"
+        "UPDATE 0 3 1.5 1.5\n"
+        "QUERY 0 3\n"
+        "DELETE 0 3\n"
+        "QUERY 0 3\n"
+        "UPDATE 0 3 -1\n"
+        "UPDATE 0 2000000000 1\n"
+        "UPDATE -1 3 1\n"
+        "STATS\n"
+        "BOGUS\n"
+        "QUIT\n"
+        "QUERY 0 3\n");
+
+    assert(lines.size() == 13);
+    assert(lines[0] == "OK 3");
+    assert(lines[1].rfind("ERR", 0) == 0);
+    assert(lines[2] == "OK 5");
+    assert(lines[3] == "OK");
+    assert(lines[4] == "OK 1.5 0 3");
+    assert(lines[5] == "OK");
+    assert(lines[6] == "OK 3 0 2 3");
+    assert(lines[7].rfind("ERR", 0) == 0);
+    // Out-of-range IDs are rejected without growing the graph
+    assert(lines[8].rfind("ERR", 0) == 0);
+    assert(lines[9].rfind("ERR", 0) == 0);
+    assert(lines[10].rfind("OK 4 4 ", 0) == 0);
+    assert(lines[11].rfind("ERR", 0) == 0);
+    assert(lines[12] == "BYE");
+    std::cout << "✅ Passed server batch/update test\n";
+}
+
+void test_batch_limits() {
+    QueryServer server(make_graph(), 1, 2);
+
+    // An oversized count is refused up front instead of sizing buffers for it
+    auto lines = run_session(server, "BATCH 4000000000\nSTATS\n");
+    assert(lines.size() == 2);
+    assert(lines[0].rfind("ERR", 0) == 0);
+    assert(lines[1].rfind("OK 4 4 ", 0) == 0);
+
+    // A stream ending mid-batch gets answers for the lines it sent only
+    lines = run_session(server, "BATCH 5\n0 3\nx\n");
+    assert(lines.size() == 2);
+    assert(lines[0] == "OK 3");
+    assert(lines[1].rfind("ERR", 0) == 0);
+    std::cout << "✅ Passed server batch limit test\n";
+}
+
+// Connect to the server's socket, waiting for it to start listening
+static int connect_client(const std::string& path) {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    for (int attempt = 0; attempt < 500; ++attempt) {
+        int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0) return fd;
+        ::close(fd);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return -1;
+}
+
+// Send one request and read back one response line
+static std::string request(int fd, const std::string& line) {
+    std::string message = line + "\n";
+    [[maybe_unused]] ssize_t sent = ::send(fd, message.data(), message.size(), 0);
+    assert(sent == static_cast<ssize_t>(message.size()));
+    std::string response;
+    char c;
+    while (::recv(fd, &c, 1, 0) == 1 && c != '\n') response += c;
+    return response;
+}
+
+void test_unix_socket() {
+    const std::string path = "test_query_server.sock";
+    QueryServer server(make_graph(), 1, 2);
+
+    // A file that is not a socket is never replaced
+    std::ofstream(path) << "keep me\n";
+    [[maybe_unused]] bool threw = false;
+    try {
+        server.serve_unix_socket(path);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    assert(std::ifstream(path).good());
+    std::remove(path.c_str());
+
+    std::thread listener([&] { server.serve_unix_socket(path); });
+
+    // An idle client does not hold up the next one
+    int idle = connect_client(path);
+    int client = connect_client(path);
+    assert(idle >= 0 && client >= 0);
+    std::string answer = request(client, "QUERY 0 3");
+    assert(answer == "OK 3 0 2 3");
+    answer = request(idle, "QUERY 0 3 1");
+    assert(answer == "OK 2 0 1 3");
+
+    // SHUTDOWN ends the idle session too, so the server returns
+    answer = request(client, "SHUTDOWN");
+    assert(answer == "BYE");
+    listener.join();
+    char c;
+    [[maybe_unused]] ssize_t received = ::recv(idle, &c, 1, 0);
+    assert(received == 0);
+    ::close(idle);
+    ::close(client);
+    assert(!std::ifstream(path).good());
+    std::cout << "✅ Passed server Unix socket test\n";
+}
+
+int main() {
+    test_queries();
+    test_repeated_queries();
+    test_batch_and_updates();
+    test_batch_limits();
+    test_unix_socket();
+    return 0;
+}
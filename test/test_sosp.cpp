@@ -1,10 +1,20 @@
 #include "../include/sosp_engine.hpp"
 #include "../include/graph.hpp"
+#include "../include/query_pool.hpp"
+#include "../include/sssp_cache.hpp"
+#include "../include/ksp_engine.hpp"
+#include "../include/indexed_heap.hpp"
+#include "../include/multiqueue_sssp.hpp"
 #include <cassert>
 #include <iostream>
 #include <chrono>
 #include <vector>
 #include <random>
+#include <set>
+#include <algorithm>
+#include <queue>
+#include <cmath>
+#include <stdexcept>
 
 // =====================
 // Original Working Tests
@@ -42,6 +52,46 @@ void test_dynamic_update() {
     std::cout << "✅ Passed dynamic update test\n";
 }
 
+void test_incremental_update() {
+    DynamicGraph graph;
+    const int NODES = 3000;
+    std::mt19937 gen(11);
+    std::uniform_int_distribution<> node_dist(0, NODES-1);
+    std::uniform_real_distribution<> weight_dist(0.5, 5.0);
+    for (int i = 0; i < NODES * 4; ++i) {
+        graph.add_edge(node_dist(gen), node_dist(gen), {weight_dist(gen)});
+    }
+
+    SOSPEngine engine(graph);
+    engine.compute(0);
+
+    // Several rounds of mixed deletions, increases, decreases and insertions
+    for (int round = 0; round < 5; ++round) {
+        std::vector<int> changed;
+        for (int i = 0; i < NODES / 50; ++i) {
+            int u = node_dist(gen);
+            const auto& edges = graph.get_edges(u);
+            if (!edges.empty() && i % 3 == 0) {
+                graph.remove_edge(u, edges[0].target);
+            } else if (!edges.empty() && i % 3 == 1) {
+                graph.set_edge(u, edges[0].target, {weight_dist(gen)});
+            } else {
+                graph.add_edge(u, node_dist(gen), {weight_dist(gen) * 0.2});
+            }
+            changed.push_back(u);
+        }
+        engine.update(changed);
+
+        QueryContext reference;
+        reference.run(graph, 0);
+        for (int node = 0; node < NODES; ++node) {
+            assert(std::abs(engine.get_distance(node) - reference.get_distance(node)) < 1e-9 ||
+                   engine.get_distance(node) == reference.get_distance(node));
+        }
+    }
+    std::cout << "✅ Passed incremental update test\n";
+}
+
 // =====================
 // Enhanced Tests (Fixed)
 // =====================
@@ -119,6 +169,13 @@ void test_random_medium_graph() {
 
     assert(engine.get_distance(0) == 0.0);
     assert(engine.get_distance(1) == 1.0); // Guaranteed by initial chain
+
+    // Nodes improved while already queued must still be expanded
+    QueryContext reference;
+    reference.run(graph, 0);
+    for (int node = 0; node < NODES; ++node) {
+        assert(std::abs(engine.get_distance(node) - reference.get_distance(node)) < 1e-9);
+    }
     std::cout << "✅ Passed random 5k node test\n";
 }
 
@@ -235,12 +292,374 @@ void test_large_sparse_graph() {
               << std::chrono::duration<double>(end-start).count() << "s\n";
 }
 
+
+void test_query_pool() {
+    DynamicGraph graph;
+    graph.add_edge(0, 1, {2.0});
+    graph.add_edge(0, 3, {4.0});
+    graph.add_edge(1, 2, {3.0});
+    graph.add_edge(1, 3, {1.0});
+    graph.add_edge(1, 4, {4.0});
+    graph.add_edge(2, 5, {1.0});
+    graph.add_edge(3, 4, {2.0});
+    graph.add_edge(4, 5, {5.0});
+
+    QueryPool pool(graph, 4);
+    auto dists = pool.distances({{0, 3}, {0, 5}, {1, 5}, {5, 0}});
+    assert(dists[0] == 3.0);
+    assert(dists[1] == 6.0);
+    assert(dists[2] == 4.0);
+    assert(dists[3] == std::numeric_limits<double>::max());
+
+    auto paths = pool.paths({{0, 5}, {5, 0}});
+    assert((paths[0].nodes == std::vector<int>{0, 1, 2, 5}));
+    assert(paths[1].nodes.empty());
+
+    // Bad IDs are rejected before any thread starts, and by the context itself
+    [[maybe_unused]] auto rejects = [](auto call) {
+        try { call(); } catch (const std::out_of_range&) { return true; }
+        return false;
+    };
+    assert(rejects([&] { pool.distances({{0, 3}, {0, 6}}); }));
+    assert(rejects([&] { pool.distances({{-1, 3}}); }));
+    assert(rejects([&] { pool.paths({{0, 5}, {6, 0}}); }));
+    assert(rejects([&] { pool.paths({{0, -1}}); }));
+    assert(rejects([&] { pool.get_context(0).run(graph, 0, 6); }));
+    assert(pool.distances({{0, -1}})[0] == std::numeric_limits<double>::max());
+
+    // Early-exit point-to-point answers must match full trees, and contexts
+    // must come back clean after being reused
+    DynamicGraph random_graph;
+    const int NODES = 2000;
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<> node_dist(0, NODES-1);
+    std::uniform_real_distribution<> weight_dist(0.5, 5.0);
+    for (int i = 0; i < NODES * 4; ++i) {
+        random_graph.add_edge(node_dist(gen), node_dist(gen), {weight_dist(gen)});
+    }
+
+    std::vector<QueryPool::Query> queries;
+    for (int i = 0; i < 500; ++i) {
+        queries.push_back({node_dist(gen), node_dist(gen)});
+    }
+    QueryPool random_pool(random_graph, 4);
+    auto batch = random_pool.distances(queries);
+
+    QueryContext reference;
+    for (size_t i = 0; i < queries.size(); ++i) {
+        reference.run(random_graph, queries[i].source);
+        assert(batch[i] == reference.get_distance(queries[i].target));
+    }
+    std::cout << "✅ Passed query pool test (" << queries.size() << " queries)\n";
+}
+
+void test_sssp_cache() {
+    DynamicGraph graph;
+    graph.add_edge(0, 1, {2.0});
+    graph.add_edge(1, 2, {2.0});
+    graph.add_edge(2, 3, {2.0});
+    graph.add_edge(0, 4, {1.0});
+    graph.add_edge(4, 3, {9.0});
+
+    const size_t tree_bytes = 5 * (sizeof(double) + sizeof(int));
+    SSSPCache cache(2 * tree_bytes);
+
+    auto tree = cache.get(graph, 0);
+    assert(tree->get_distance(3) == 6.0);
+    assert(cache.get(graph, 0) == tree);
+    assert(cache.get_hits() == 1 && cache.get_misses() == 1);
+
+    // Decrease on a non-tree edge: repaired, not recomputed
+    EdgeChange decrease{4, 3, graph.find_edge(4, 3)->weights, {0.5}};
+    graph.set_edge(4, 3, {0.5});
+    cache.apply_changes(graph, {decrease});
+    assert(cache.get_repairs() == 1);
+    auto repaired = cache.get(graph, 0);
+    assert(repaired->get_distance(3) == 1.5);
+    assert((repaired->get_path(3) == std::vector<int>{0, 4, 3}));
+    assert(tree->get_distance(3) == 6.0); // earlier handle is unchanged
+
+    // Increase off the tree keeps the entry, on the tree evicts it
+    EdgeChange off_tree{2, 3, graph.find_edge(2, 3)->weights, {5.0}};
+    graph.set_edge(2, 3, {5.0});
+    cache.apply_changes(graph, {off_tree});
+    assert(cache.size() == 1);
+
+    EdgeChange removal{4, 3, graph.find_edge(4, 3)->weights, {}};
+    graph.remove_edge(4, 3);
+    cache.apply_changes(graph, {removal});
+    assert(cache.size() == 0 && cache.get_invalidations() == 1);
+    assert(cache.get(graph, 0)->get_distance(3) == 9.0);
+
+    // LRU eviction under the memory budget
+    cache.get(graph, 1);
+    cache.get(graph, 0);
+    cache.get(graph, 2);
+    assert(cache.size() == 2 && cache.memory_used() <= 2 * tree_bytes);
+    assert(cache.peek(1, 0) == nullptr);
+    assert(cache.peek(0, 0) != nullptr);
+    std::cout << "✅ Passed SSSP cache test\n";
+}
+
+// Every simple source -> target path with its cost (integer weights, exact sums)
+static void enumerate_simple_paths(const DynamicGraph& graph, int u, int target, std::vector<int>& path,
+                                   std::vector<char>& on_path, double cost,
+                                   std::vector<std::pair<double, std::vector<int>>>& out) {
+    if (u == target) {
+        out.push_back({cost, path});
+        return;
+    }
+    for (const auto& edge : graph.get_edges(u)) {
+        if (on_path[edge.target]) continue;
+        on_path[edge.target] = 1;
+        path.push_back(edge.target);
+        enumerate_simple_paths(graph, edge.target, target, path, on_path, cost + edge.weights[0], out);
+        path.pop_back();
+        on_path[edge.target] = 0;
+    }
+}
+
+void test_k_shortest_paths() {
+    std::mt19937 gen(17);
+    std::uniform_int_distribution<> weight(1, 6);
+    for (int trial = 0; trial < 10; ++trial) {
+        const int NODES = 12;
+        std::uniform_int_distribution<> node_dist(0, NODES - 1);
+        DynamicGraph graph(NODES);
+        for (int i = 0; i < 40; ++i) {
+            int u = node_dist(gen), v = node_dist(gen);
+            if (u != v) graph.set_edge(u, v, {double(weight(gen))});
+        }
+
+        std::vector<std::pair<double, std::vector<int>>> all;
+        std::vector<int> path{0};
+        std::vector<char> on_path(NODES, 0);
+        on_path[0] = 1;
+        enumerate_simple_paths(graph, 0, NODES - 1, path, on_path, 0.0, all);
+        std::sort(all.begin(), all.end());
+
+        for (int threads : {1, 3}) {
+            KShortestPaths ksp(graph, 0, threads);
+            auto paths = ksp.compute(0, NODES - 1, 15);
+            assert(paths.size() == std::min<size_t>(15, all.size()));
+
+            std::set<std::vector<int>> distinct;
+            for (size_t i = 0; i < paths.size(); ++i) {
+                assert(paths[i].objectives[0] == all[i].first);  // same ranked costs
+                distinct.insert(paths[i].nodes);
+
+                // Loopless, connected, correctly priced
+                std::vector<int> sorted = paths[i].nodes;
+                std::sort(sorted.begin(), sorted.end());
+                assert(std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end());
+                double cost = 0.0;
+                for (size_t h = 0; h + 1 < paths[i].nodes.size(); ++h) {
+                    const auto* edge = graph.find_edge(paths[i].nodes[h], paths[i].nodes[h + 1]);
+                    assert(edge);
+                    cost += edge->weights[0];
+                }
+                assert(cost == paths[i].objectives[0]);
+            }
+            assert(distinct.size() == paths.size());
+        }
+    }
+
+    DynamicGraph graph;
+    graph.add_edge(0, 1, {1.0});
+    KShortestPaths ksp(graph);
+    assert(ksp.compute(0, 1, 5).size() == 1);
+    assert(ksp.compute(1, 0, 5).empty());
+    assert(ksp.compute(0, 1, 0).empty());
+    std::cout << "✅ Passed k-shortest paths test\n";
+}
+
+void test_indexed_heap() {
+    // Decrease-key keeps one entry per node and pops in key order
+    IndexedDaryHeap<4> heap;
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<> key_dist(0.0, 100.0);
+    std::vector<double> best(500, std::numeric_limits<double>::max());
+    for (int i = 0; i < 5000; ++i) {
+        int node = i % 500;
+        double key = key_dist(gen);
+        [[maybe_unused]] bool lowered = heap.push(node, key);
+        assert(lowered == (key < best[node]));
+        best[node] = std::min(best[node], key);
+    }
+    assert(heap.size() == 500 && heap.contains(42));
+    [[maybe_unused]] double last = -1.0;
+    while (!heap.empty()) {
+        auto [key, node] = heap.pop();
+        assert(key >= last && key == best[node] && !heap.contains(node));
+        last = key;
+    }
+
+    // Both queue policies give the same trees on a dense graph
+    const int NODES = 1500;
+    DynamicGraph graph;
+    std::uniform_int_distribution<> node_dist(0, NODES - 1);
+    for (int i = 0; i < NODES * 60; ++i) {
+        graph.add_edge(node_dist(gen), node_dist(gen), {key_dist(gen)});
+    }
+    BasicSOSPEngine<ObjectiveWeight, IndexedDaryHeap<4>> indexed(graph);
+    BasicSOSPEngine<ObjectiveWeight, LazyBinaryHeap> lazy(graph);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    indexed.compute(0);
+    auto mid = std::chrono::high_resolution_clock::now();
+    lazy.compute(0);
+    auto end = std::chrono::high_resolution_clock::now();
+    for (int v = 0; v < NODES; ++v) assert(indexed.get_distance(v) == lazy.get_distance(v));
+
+    // Sequential point-to-point queries agree with the engine
+    QueryContext ctx;
+    ctx.run(graph, 0);
+    for (int v = 0; v < NODES; ++v) assert(ctx.get_distance(v) == indexed.get_distance(v));
+
+    std::cout << "✅ Passed indexed heap test (indexed "
+              << std::chrono::duration<double, std::milli>(mid - start).count() << " ms vs lazy "
+              << std::chrono::duration<double, std::milli>(end - mid).count() << " ms)\n";
+}
+
+// Plain binary-heap Dijkstra on doubles, the reference for the integer queue
+static std::vector<double> heap_dijkstra(const DynamicGraph& graph, int source) {
+    std::vector<double> dist(graph.node_count(), std::numeric_limits<double>::max());
+    std::priority_queue<std::pair<double, int>, std::vector<std::pair<double, int>>, std::greater<>> pq;
+    dist[source] = 0.0;
+    pq.emplace(0.0, source);
+    while (!pq.empty()) {
+        auto [d, u] = pq.top();
+        pq.pop();
+        if (d > dist[u]) continue;
+        for (const auto& edge : graph.get_edges(u)) {
+            if (d + edge.weights[0] < dist[edge.target]) {
+                dist[edge.target] = d + edge.weights[0];
+                pq.emplace(dist[edge.target], edge.target);
+            }
+        }
+    }
+    return dist;
+}
+
+void test_integer_weight_queue() {
+    // Integrality is tracked as edges come and go
+    DynamicGraph small;
+    small.add_edge(0, 1, {3.0, 0.5});
+    assert(small.get_weight_quantum(0) == 1.0 && small.get_weight_quantum(1) == 0.0);
+    small.set_edge(0, 1, {3.5, 1.0});
+    assert(small.get_weight_quantum(0) == 0.0 && small.get_weight_quantum(1) == 1.0);
+    small.remove_edge(0, 1);
+    assert(small.get_weight_quantum(0) == 1.0);
+    small.add_edge(0, 1, {-2.0});
+    assert(small.get_weight_quantum(0) == 0.0);
+
+    // Road-like grid with integer deciseconds
+    const int SIDE = 300;
+    DynamicGraph graph;
+    std::mt19937 gen(11);
+    std::uniform_int_distribution<> weight_dist(10, 600);
+    for (int r = 0; r < SIDE; ++r) {
+        for (int c = 0; c < SIDE; ++c) {
+            int u = r * SIDE + c;
+            if (c + 1 < SIDE) {
+                graph.add_edge(u, u + 1, {double(weight_dist(gen))});
+                graph.add_edge(u + 1, u, {double(weight_dist(gen))});
+            }
+            if (r + 1 < SIDE) {
+                graph.add_edge(u, u + SIDE, {double(weight_dist(gen))});
+                graph.add_edge(u + SIDE, u, {double(weight_dist(gen))});
+            }
+        }
+    }
+    assert(graph.get_weight_quantum(0) == 1.0);
+
+    QueryContext ctx;
+    const int sources[] = {0, SIDE * SIDE / 2 + SIDE / 3, SIDE * SIDE - 1};
+    double radix_time = 0, heap_time = 0;
+    for (int source : sources) {
+        auto start = std::chrono::high_resolution_clock::now();
+        ctx.run(graph, source);
+        auto mid = std::chrono::high_resolution_clock::now();
+        std::vector<double> expected = heap_dijkstra(graph, source);
+        auto end = std::chrono::high_resolution_clock::now();
+        radix_time += std::chrono::duration<double>(mid - start).count();
+        heap_time += std::chrono::duration<double>(end - mid).count();
+
+        for (int v = 0; v < SIDE * SIDE; ++v) assert(ctx.get_distance(v) == expected[v]);
+        std::vector<int> path = ctx.get_path(SIDE * SIDE / 3);
+        double cost = 0;
+        for (size_t h = 0; h + 1 < path.size(); ++h) cost += graph.find_edge(path[h], path[h + 1])->weights[0];
+        assert(cost == expected[SIDE * SIDE / 3]);
+        assert(ctx.run(graph, source, SIDE - 1) == expected[SIDE - 1]);
+    }
+
+    // Declared quantum: the same grid in seconds with one decimal
+    DynamicGraph seconds(SIDE * SIDE);
+    for (int u = 0; u < SIDE * SIDE; ++u) {
+        for (const auto& edge : graph.get_edges(u)) seconds.add_edge(u, edge.target, {edge.weights[0] / 10});
+    }
+    assert(seconds.get_weight_quantum(0) == 0.0);
+    std::vector<double> expected = heap_dijkstra(seconds, 0);
+    seconds.set_weight_quantum(0, 0.1);
+    ctx.run(seconds, 0);
+    for (int v = 0; v < SIDE * SIDE; ++v) assert(std::abs(ctx.get_distance(v) - expected[v]) < 1e-6);
+
+    std::cout << "✅ Passed integer weight queue test (radix heap "
+              << radix_time * 1000 << " ms vs binary heap " << heap_time * 1000 << " ms)\n";
+}
+
+void test_multiqueue_sssp() {
+    const int NODES = 20000;
+    DynamicGraph graph;
+    std::mt19937 gen(23);
+    std::uniform_int_distribution<> node_dist(0, NODES - 1);
+    std::uniform_real_distribution<> weight_dist(0.5, 20.0);
+    for (int i = 0; i < NODES * 5; ++i) {
+        graph.add_edge(node_dist(gen), node_dist(gen), {weight_dist(gen)});
+    }
+    graph.add_node(NODES);  // unreachable
+
+    QueryContext reference;
+    reference.run(graph, 0);
+
+    for (int threads : {1, 4}) {
+        MultiQueueSSSP engine(graph, 0, threads);
+        for (int round = 0; round < 2; ++round) {  // reuse must start clean
+            auto start = std::chrono::high_resolution_clock::now();
+            engine.compute(0);
+            auto end = std::chrono::high_resolution_clock::now();
+
+            for (int v = 0; v <= NODES; ++v) assert(engine.get_distance(v) == reference.get_distance(v));
+            assert(engine.get_path(NODES).empty());
+
+            // Predecessors form shortest paths
+            std::vector<int> path = engine.get_path(NODES / 2);
+            double cost = 0;
+            for (size_t h = 0; h + 1 < path.size(); ++h) {
+                double best = std::numeric_limits<double>::max();
+                for (const auto& edge : graph.get_edges(path[h])) {
+                    if (edge.target == path[h + 1]) best = std::min(best, edge.weights[0]);
+                }
+                cost += best;
+            }
+            assert(path.front() == 0 && std::abs(cost - reference.get_distance(NODES / 2)) < 1e-9);
+
+            if (round == 0) {
+                std::cout << "  MultiQueue SSSP with " << threads << " threads: "
+                          << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+            }
+        }
+    }
+    std::cout << "✅ Passed MultiQueue SSSP test\n";
+}
+
 int main() {
     std::cout << "=== Running SOSP Engine Tests ===\n";
     
     try {
         test_parallel_dijkstra();
         test_dynamic_update();
+        test_incremental_update();
         test_disconnected_components();
         test_memory_efficiency();
         test_random_medium_graph();
@@ -252,6 +671,14 @@ int main() {
     
     // Large graph (memory-safe sparse structure)
     test_large_sparse_graph();
+
+    // Batched point-to-point queries
+    test_query_pool();
+    test_sssp_cache();
+    test_k_shortest_paths();
+    test_integer_weight_queue();
+    test_indexed_heap();
+    test_multiqueue_sssp();
         
         std::cout << "=== All tests passed successfully! ===\n";
         return 0;